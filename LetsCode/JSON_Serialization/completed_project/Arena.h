@@ -0,0 +1,94 @@
+#ifndef BOQ_ARENA_H
+#define BOQ_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+/// Bump allocator: memory is handed out from large blocks by advancing a pointer, and released all at once when the
+/// arena is reset or destroyed. Only for trivially destructible objects, no destructors are run.
+class Arena
+{
+  public:
+    static constexpr size_t default_block_size = 64 * 1024;
+
+    explicit Arena(size_t block_size = default_block_size) : m_block_size(block_size)
+    {
+    }
+    Arena(const Arena &)            = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    void *
+    allocate(size_t size, size_t alignment)
+    {
+        if (size + alignment > m_block_size)
+        {
+            // too large for the blocks, gets a block of its own
+            m_blocks.push_back(std::make_unique_for_overwrite<std::byte[]>(size + alignment));
+            std::byte *block = m_blocks.back().get();
+            return block + padding(block, alignment);
+        }
+        if (m_current == nullptr || static_cast<size_t>(m_end - m_current) < padding(m_current, alignment) + size)
+        {
+            next_block();
+        }
+        std::byte *result = m_current + padding(m_current, alignment);
+        m_current         = result + size;
+        return result;
+    }
+
+    /// Uninitialized array of n objects of type T.
+    template <typename T>
+    T *
+    allocate_array(size_t n)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "the arena doesn't run destructors");
+        return static_cast<T *>(allocate(n * sizeof(T), alignof(T)));
+    }
+
+    /// Releases all allocations at once. The memory of the first block is kept for reuse.
+    void
+    reset()
+    {
+        if (m_blocks.empty())
+        {
+            return;
+        }
+        m_blocks.resize(1);
+        m_current = m_blocks.front().get();
+        m_end     = m_current + m_block_size;
+    }
+
+    /// Number of blocks allocated from the heap.
+    size_t
+    block_count() const
+    {
+        return m_blocks.size();
+    }
+
+  private:
+    // the blocks of m_block_size bytes, and larger blocks each holding a single allocation
+    std::vector<std::unique_ptr<std::byte[]>> m_blocks;
+    std::byte                                *m_current = nullptr;
+    std::byte                                *m_end     = nullptr;
+    size_t                                    m_block_size;
+
+    static size_t
+    padding(const std::byte *p, size_t alignment)
+    {
+        auto address = reinterpret_cast<uintptr_t>(p);
+        return (alignment - address % alignment) % alignment;
+    }
+
+    void
+    next_block()
+    {
+        m_blocks.push_back(std::make_unique_for_overwrite<std::byte[]>(m_block_size));
+        m_current = m_blocks.back().get();
+        m_end     = m_current + m_block_size;
+    }
+};
+
+#endif // BOQ_ARENA_H
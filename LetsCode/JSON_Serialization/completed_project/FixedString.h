@@ -0,0 +1,26 @@
+#ifndef BOQ_FIXED_STRING_H
+#define BOQ_FIXED_STRING_H
+
+#include <algorithm>
+#include <cstddef>
+#include <string_view>
+
+/// String literal that can be used as a template parameter, e.g. nvp<"street_name">(value).
+template <size_t N>
+struct fixed_string
+{
+    char data[N]{};
+
+    constexpr fixed_string(const char (&s)[N])
+    {
+        std::copy_n(s, N, data);
+    }
+
+    constexpr std::string_view
+    view() const
+    {
+        return {data, N - 1};
+    }
+};
+
+#endif // BOQ_FIXED_STRING_H
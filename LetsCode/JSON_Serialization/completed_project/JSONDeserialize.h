@@ -0,0 +1,319 @@
+#ifndef BOQ_JSON_DESERIALIZE_H
+#define BOQ_JSON_DESERIALIZE_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+#include "JSONNumber.h"
+#include "JSONReader.h"
+#include "JSONReflection.h"
+
+// Deserialization, the counterpart of the JSONWriter: deserialize(reader, value) reads the next value from a
+// JSONReader into value. Builtin types, strings and lists are supported out of the box, objects are read into types
+// with a reflection table (see JSONReflection.h). Other types can be supported with a deserialize overload:
+//
+//   void deserialize(JSONReader &reader, MyType &value);
+//
+// The keys of an object are dispatched to the members with a perfect hash table generated at compile time from the
+// field names, so a key is matched with one hash and one string comparison regardless of the number of fields. Keys
+// may appear in any order, unknown keys are skipped and members whose key is missing keep their value.
+// Numbers are converted by json_number::parse (see JSONNumber.h), doubles round-trip the output of the JSONWriter.
+// Input that doesn't match the type (e.g. a string for an int member) throws a JSONParseError.
+
+namespace json_detail
+{
+    inline void
+    expect(JSONReader &reader, JSONEvent expected, const char *message)
+    {
+        if (reader.next() != expected)
+        {
+            throw JSONParseError(message, reader.offset());
+        }
+    }
+
+    /// Concept for the containers a JSON array is read into.
+    template <typename T>
+    concept GrowableList = requires(T t) {
+        t.clear();
+        t.emplace_back();
+        t.back();
+        requires !std::is_convertible_v<T, std::string>;
+    };
+} // namespace json_detail
+
+template <typename T>
+void
+deserialize(JSONReader &, T &)
+{
+    static_assert(!std::is_same_v<T, T>, "Type can't be deserialized from JSON");
+}
+
+inline void
+deserialize(JSONReader &reader, bool &b)
+{
+    json_detail::expect(reader, JSONEvent::boolean, "expected a boolean");
+    b = reader.bool_value();
+}
+
+template <typename T>
+    requires(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>)
+void
+deserialize(JSONReader &reader, T &t)
+{
+    json_detail::expect(reader, JSONEvent::number, "expected a number");
+    if (!json_number::parse(reader.string_value(), t))
+    {
+        // a fraction or exponent for an integer, or out of range
+        throw JSONParseError("number can't be represented in the type", reader.offset());
+    }
+}
+
+inline void
+deserialize(JSONReader &reader, std::string &s)
+{
+    json_detail::expect(reader, JSONEvent::string, "expected a string");
+    s.assign(reader.string_value());
+}
+
+template <json_detail::GrowableList L>
+void
+deserialize(JSONReader &reader, L &list)
+{
+    json_detail::expect(reader, JSONEvent::begin_array, "expected an array");
+    list.clear();
+    while (reader.peek() != JSONEvent::end_array)
+    {
+        list.emplace_back();
+        deserialize(reader, list.back());
+    }
+    reader.next();
+}
+
+namespace json_detail
+{
+    /// Finalizer of MurmurHash3, every bit of the result depends on every bit of h.
+    constexpr uint64_t
+    mix(uint64_t h)
+    {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccd;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53;
+        h ^= h >> 33;
+        return h;
+    }
+
+    /// FNV-1a followed by a finalizer. Field names often differ only in a few characters (field_1, field_2, ...),
+    /// which FNV-1a alone doesn't spread over all bits.
+    constexpr uint64_t
+    hash_key(std::string_view key)
+    {
+        uint64_t h = 0xcbf29ce484222325;
+        for (char c : key)
+        {
+            h = (h ^ static_cast<unsigned char>(c)) * 0x100000001b3;
+        }
+        return mix(h);
+    }
+
+    /// Perfect hash table of N keys (hash and displace): the hash of a key selects a bucket, and each bucket has a seed
+    /// which places its keys in distinct slots. The seeds are searched at compile time, so a lookup is one pass over
+    /// the key and one comparison with the name stored in its slot.
+    template <size_t N>
+    struct perfect_hash_table
+    {
+        static constexpr size_t n_slots = std::bit_ceil(std::max<size_t>(N, 1));
+
+        std::array<uint32_t, n_slots>         seeds{};
+        std::array<std::string_view, n_slots> names{};
+        std::array<size_t, n_slots>           indices{};
+
+        static constexpr size_t
+        bucket(uint64_t h)
+        {
+            return (h >> 32) & (n_slots - 1);
+        }
+
+        static constexpr size_t
+        slot(uint64_t h, uint32_t seed)
+        {
+            return mix(h + seed) & (n_slots - 1);
+        }
+
+        /// Index of the key in the names the table was built from, N if it isn't one of them.
+        constexpr size_t
+        find(std::string_view key) const
+        {
+            uint64_t h = hash_key(key);
+            size_t   s = slot(h, seeds[bucket(h)]);
+            return indices[s] != N && names[s] == key ? indices[s] : N;
+        }
+    };
+
+    template <size_t N>
+    constexpr perfect_hash_table<N>
+    make_perfect_hash(const std::array<std::string_view, N> &names)
+    {
+        using table_t = perfect_hash_table<N>;
+        table_t table;
+        table.indices.fill(N);
+
+        std::array<uint64_t, N>              hashes{};
+        std::array<size_t, table_t::n_slots> bucket_sizes{};
+        std::array<size_t, table_t::n_slots> bucket_order{};
+        std::array<bool, table_t::n_slots>   used{};
+        for (size_t i = 0; i < N; ++i)
+        {
+            for (size_t j = 0; j < i; ++j)
+            {
+                if (names[i] == names[j])
+                {
+                    throw std::logic_error("duplicate field name");
+                }
+            }
+            hashes[i] = hash_key(names[i]);
+            ++bucket_sizes[table_t::bucket(hashes[i])];
+        }
+
+        // place the largest buckets first, while most slots are still free
+        for (size_t b = 0; b < table_t::n_slots; ++b)
+        {
+            bucket_order[b] = b;
+        }
+        std::sort(bucket_order.begin(), bucket_order.end(),
+                  [&](size_t a, size_t b) { return bucket_sizes[a] > bucket_sizes[b]; });
+
+        for (size_t b : bucket_order)
+        {
+            if (bucket_sizes[b] == 0)
+            {
+                break;
+            }
+            for (uint32_t seed = 0;; ++seed)
+            {
+                if (seed == 1'000'000)
+                {
+                    throw std::logic_error("no perfect hash found");
+                }
+                std::array<size_t, N> slots{};
+                size_t                n_placed = 0;
+                bool                  fits     = true;
+                for (size_t i = 0; i < N && fits; ++i)
+                {
+                    if (table_t::bucket(hashes[i]) != b)
+                    {
+                        continue;
+                    }
+                    size_t s = table_t::slot(hashes[i], seed);
+                    fits     = !used[s];
+                    for (size_t j = 0; j < n_placed; ++j)
+                    {
+                        fits = fits && slots[j] != s;
+                    }
+                    slots[n_placed++] = s;
+                }
+                if (!fits)
+                {
+                    continue;
+                }
+                table.seeds[b] = seed;
+                for (size_t i = 0; i < N; ++i)
+                {
+                    if (table_t::bucket(hashes[i]) == b)
+                    {
+                        size_t s         = table_t::slot(hashes[i], seed);
+                        used[s]          = true;
+                        table.names[s]   = names[i];
+                        table.indices[s] = i;
+                    }
+                }
+                break;
+            }
+        }
+        return table;
+    }
+
+    template <JSONReflected T>
+    constexpr auto
+    field_names()
+    {
+        return std::apply(
+            []<typename... FIELDS>(FIELDS...) {
+                return std::array<std::string_view, sizeof...(FIELDS)>{FIELDS::name...};
+            },
+            json_fields<T>::value);
+    }
+
+    /// Maps keys to field indices with a perfect hash table.
+    template <JSONReflected T>
+    struct perfect_hash_lookup
+    {
+        static constexpr auto table = make_perfect_hash(field_names<T>());
+
+        static size_t
+        find(std::string_view key)
+        {
+            return table.find(key);
+        }
+    };
+
+    /// Maps keys to field indices by comparing the key with every field name.
+    template <JSONReflected T>
+    struct linear_lookup
+    {
+        static constexpr auto names = field_names<T>();
+
+        static size_t
+        find(std::string_view key)
+        {
+            return static_cast<size_t>(std::find(names.begin(), names.end(), key) - names.begin());
+        }
+    };
+
+    /// One function per field, reading the field's value into the member.
+    template <JSONReflected T>
+    inline constexpr auto field_readers = std::apply(
+        []<typename... FIELDS>(FIELDS...) {
+            return std::array<void (*)(JSONReader &, T &), sizeof...(FIELDS)>{
+                [](JSONReader &reader, T &value) { deserialize(reader, value.*FIELDS::member); }...};
+        },
+        json_fields<T>::value);
+
+    /// Reads an object into a reflected type, LOOKUP maps the keys to the indices of the fields.
+    template <typename LOOKUP, JSONReflected T>
+    void
+    deserialize_object(JSONReader &reader, T &value)
+    {
+        constexpr auto &readers = field_readers<T>;
+        expect(reader, JSONEvent::begin_object, "expected an object");
+        // after begin_object, the reader only produces keys until the end of the object
+        while (reader.next() != JSONEvent::end_object)
+        {
+            if (size_t index = LOOKUP::find(reader.string_value()); index < readers.size())
+            {
+                readers[index](reader, value);
+            }
+            else
+            {
+                reader.skip_value();
+            }
+        }
+    }
+} // namespace json_detail
+
+template <JSONReflected T>
+void
+deserialize(JSONReader &reader, T &value)
+{
+    json_detail::deserialize_object<json_detail::perfect_hash_lookup<T>>(reader, value);
+}
+
+#endif // BOQ_JSON_DESERIALIZE_H
@@ -0,0 +1,530 @@
+#ifndef BOQ_JSON_DOCUMENT_H
+#define BOQ_JSON_DOCUMENT_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Arena.h"
+#include "JSONDeserialize.h"
+#include "JSONReader.h"
+#include "JSONStructuralIndex.h"
+
+// Lazy (on-demand) access to JSON documents. Creating a LazyDocument only builds the structural index of the input,
+// the values are parsed when they are accessed:
+//
+//   LazyDocument doc{json};
+//   int          id   = doc.root()["id"].get<int>();
+//   std::string_view street = doc.root()["address"]["street_name"].as_string();
+//
+// Looking up a key walks the members of the object on the index and skips the values of the other members by brace
+// matching on the index, without looking at their content. Only the accessed values are validated.
+// The nodes materialized by as_object() and as_array(), and strings that had to be unescaped, are allocated from an
+// arena of the document and freed together with it.
+
+enum class JSONType
+{
+    object,
+    array,
+    string,
+    number,
+    boolean,
+    null,
+};
+
+class LazyDocument;
+class LazyObject;
+class LazyArray;
+
+/// Handle to a value in a LazyDocument, valid as long as the document. Throws JSONParseError when the accessed value
+/// is malformed or has a different type, and std::out_of_range for missing keys and indices.
+class LazyValue
+{
+  public:
+    JSONType type() const;
+
+    /// Looks up a member of an object, scanning the members up to the key.
+    std::optional<LazyValue> find_field(std::string_view key) const;
+    LazyValue                operator[](std::string_view key) const;
+
+    /// Materializes all members of an object, for iteration or repeated lookups.
+    LazyObject as_object() const;
+    /// Materializes the positions of all elements of an array, for indexing.
+    LazyArray as_array() const;
+
+    /// The string, a view into the input unless it contains escape sequences.
+    std::string_view as_string() const;
+
+    bool is_null() const;
+
+    /// Parses the value with deserialize (see JSONDeserialize.h), e.g. get<int>() or get<std::vector<double>>().
+    template <typename T>
+    T
+    get() const;
+
+  private:
+    friend class LazyDocument;
+    friend class LazyObject;
+    friend class LazyArray;
+
+    LazyValue(LazyDocument &document, size_t token) : m_document(&document), m_token(token)
+    {
+    }
+
+    LazyDocument *m_document;
+    size_t        m_token; // position of the value in the structural index
+};
+
+namespace json_detail
+{
+    struct lazy_field
+    {
+        std::string_view key;
+        size_t           value_token;
+    };
+} // namespace json_detail
+
+/// The members of an object, allocated in the document's arena.
+class LazyObject
+{
+  public:
+    size_t
+    size() const
+    {
+        return m_size;
+    }
+
+    std::string_view
+    key(size_t i) const
+    {
+        return m_fields[i].key;
+    }
+
+    LazyValue
+    value(size_t i) const
+    {
+        return LazyValue{*m_document, m_fields[i].value_token};
+    }
+
+    std::optional<LazyValue>
+    find(std::string_view key) const
+    {
+        for (size_t i = 0; i < m_size; ++i)
+        {
+            if (m_fields[i].key == key)
+            {
+                return value(i);
+            }
+        }
+        return std::nullopt;
+    }
+
+    LazyValue
+    operator[](std::string_view key) const
+    {
+        if (auto result = find(key))
+        {
+            return *result;
+        }
+        throw std::out_of_range("LazyObject: no member " + std::string(key));
+    }
+
+  private:
+    friend class LazyValue;
+
+    LazyObject(LazyDocument &document, const json_detail::lazy_field *fields, size_t size)
+        : m_document(&document), m_fields(fields), m_size(size)
+    {
+    }
+
+    LazyDocument                  *m_document;
+    const json_detail::lazy_field *m_fields;
+    size_t                         m_size;
+};
+
+/// The element positions of an array, allocated in the document's arena.
+class LazyArray
+{
+  public:
+    size_t
+    size() const
+    {
+        return m_size;
+    }
+
+    LazyValue
+    operator[](size_t i) const
+    {
+        if (i >= m_size)
+        {
+            throw std::out_of_range("LazyArray: index out of range");
+        }
+        return LazyValue{*m_document, m_element_tokens[i]};
+    }
+
+  private:
+    friend class LazyValue;
+
+    LazyArray(LazyDocument &document, const size_t *element_tokens, size_t size)
+        : m_document(&document), m_element_tokens(element_tokens), m_size(size)
+    {
+    }
+
+    LazyDocument *m_document;
+    const size_t *m_element_tokens;
+    size_t        m_size;
+};
+
+/// A JSON document that is parsed on demand, see above. The input has to outlive the document.
+/// Like the values, the structure is only checked where it is accessed: the constructor doesn't walk the document, so
+/// unbalanced brackets in skipped values, or a second value after a root array or object, aren't detected.
+class LazyDocument
+{
+  public:
+    explicit LazyDocument(std::string_view input) : m_input(input), m_index(input)
+    {
+        check_single_value();
+    }
+    LazyDocument(const LazyDocument &)            = delete;
+    LazyDocument &operator=(const LazyDocument &) = delete;
+
+    /// Replaces the document with another one, reusing the memory of the index and the arena. Invalidates the values
+    /// and strings obtained from the previous document.
+    void
+    load(std::string_view input)
+    {
+        m_input = input;
+        m_index.build(input);
+        m_arena.reset();
+        check_single_value();
+    }
+
+    LazyValue
+    root()
+    {
+        return LazyValue{*this, 0};
+    }
+
+    const Arena &
+    arena() const
+    {
+        return m_arena;
+    }
+
+  private:
+    friend class LazyValue;
+
+    std::string_view    m_input;
+    StructuralIndex     m_index;
+    Arena               m_arena;
+    std::vector<size_t> m_scratch; // element positions while materializing an array
+
+    void
+    check_single_value() const
+    {
+        size_t n_tokens = m_index.size();
+        if (n_tokens == 0)
+        {
+            throw JSONParseError("unexpected end of input", m_input.size());
+        }
+        char first        = token_char(0);
+        char last         = token_char(n_tokens - 1);
+        bool single_value = first == '{' ? last == '}' : first == '[' ? last == ']' : n_tokens == 1;
+        if (!single_value)
+        {
+            throw JSONParseError("expected a single value", offset(n_tokens - 1));
+        }
+    }
+
+    size_t
+    offset(size_t token) const
+    {
+        return token < m_index.size() ? m_index.begin()[token] : m_input.size();
+    }
+
+    char
+    token_char(size_t token) const
+    {
+        return token < m_index.size() ? m_input[m_index.begin()[token]] : '\0';
+    }
+
+    [[noreturn]] void
+    error(const char *message, size_t token) const
+    {
+        throw JSONParseError(message, offset(token));
+    }
+
+    /// Reader positioned at the value, to parse it
+    JSONReader
+    reader_at(size_t token) const
+    {
+        return JSONReader{m_input.substr(offset(token))};
+    }
+
+    /// Returns the token after the value starting at token. Objects and arrays are skipped by counting the braces and
+    /// brackets on the index, strings never contain tokens.
+    size_t
+    skip(size_t token) const
+    {
+        char c = token_char(token);
+        if (c != '{' && c != '[')
+        {
+            if (token >= m_index.size())
+            {
+                error("unexpected end of input", token);
+            }
+            return token + 1;
+        }
+        const uint32_t *positions = m_index.begin();
+        size_t          depth     = 0;
+        for (size_t t = token; t < m_index.size(); ++t)
+        {
+            char next = m_input[positions[t]];
+            depth += static_cast<size_t>(next == '{' || next == '[');
+            depth -= static_cast<size_t>(next == '}' || next == ']');
+            if (depth == 0)
+            {
+                return t + 1;
+            }
+        }
+        error("unexpected end of input", token);
+    }
+
+    /// Calls func(key_token, value_token) for the members of the object at token until it returns false.
+    template <typename FUNC>
+    void
+    for_each_field(size_t token, FUNC &&func) const
+    {
+        if (token_char(token) != '{')
+        {
+            error("expected an object", token);
+        }
+        size_t t = token + 1;
+        if (token_char(t) == '}')
+        {
+            return;
+        }
+        while (true)
+        {
+            if (token_char(t) != '"')
+            {
+                error("expected a string as object key", t);
+            }
+            if (token_char(t + 1) != ':')
+            {
+                error("expected ':' after object key", t + 1);
+            }
+            if (!func(t, t + 2))
+            {
+                return;
+            }
+            t = skip(t + 2);
+            if (char c = token_char(t); c == ',')
+            {
+                ++t;
+            }
+            else if (c == '}')
+            {
+                return;
+            }
+            else
+            {
+                error("expected ',' or the end of the object", t);
+            }
+        }
+    }
+
+    /// Calls func(value_token) for the elements of the array at token.
+    template <typename FUNC>
+    void
+    for_each_element(size_t token, FUNC &&func) const
+    {
+        if (token_char(token) != '[')
+        {
+            error("expected an array", token);
+        }
+        size_t t = token + 1;
+        if (token_char(t) == ']')
+        {
+            return;
+        }
+        while (true)
+        {
+            func(t);
+            t = skip(t);
+            if (char c = token_char(t); c == ',')
+            {
+                ++t;
+            }
+            else if (c == ']')
+            {
+                return;
+            }
+            else
+            {
+                error("expected ',' or the end of the array", t);
+            }
+        }
+    }
+
+    /// The raw text of the key between the quotes. The ':' follows the closing quote, with only whitespace in between.
+    std::string_view
+    raw_key(size_t key_token) const
+    {
+        size_t           begin = offset(key_token) + 1;
+        std::string_view raw   = m_input.substr(begin, offset(key_token + 1) - begin);
+        while (raw.back() != '"')
+        {
+            raw.remove_suffix(1);
+        }
+        raw.remove_suffix(1);
+        return raw;
+    }
+
+    bool
+    key_equals(size_t key_token, std::string_view key) const
+    {
+        std::string_view raw = raw_key(key_token);
+        if (std::memchr(raw.data(), '\\', raw.size()) == nullptr)
+        {
+            return raw == key;
+        }
+        JSONReader reader = reader_at(key_token);
+        reader.next();
+        return reader.string_value() == key;
+    }
+
+    /// Makes a string that isn't a view into the input (it was unescaped by a reader) permanent.
+    std::string_view
+    keep(std::string_view s)
+    {
+        // std::less_equal and std::greater_equal give a total order, also for pointers into unrelated objects
+        const char *begin = m_input.data();
+        const char *end   = begin + m_input.size();
+        if (std::greater_equal<>{}(s.data(), begin) && std::less_equal<>{}(s.data() + s.size(), end))
+        {
+            return s;
+        }
+        char *copy = m_arena.allocate_array<char>(s.size());
+        std::memcpy(copy, s.data(), s.size());
+        return {copy, s.size()};
+    }
+};
+
+inline JSONType
+LazyValue::type() const
+{
+    switch (m_document->token_char(m_token))
+    {
+    case '{':
+        return JSONType::object;
+    case '[':
+        return JSONType::array;
+    case '"':
+        return JSONType::string;
+    case 't':
+    case 'f':
+        return JSONType::boolean;
+    case 'n':
+        return JSONType::null;
+    default:
+        return JSONType::number;
+    }
+}
+
+inline std::optional<LazyValue>
+LazyValue::find_field(std::string_view key) const
+{
+    std::optional<LazyValue> result;
+    m_document->for_each_field(m_token, [&](size_t key_token, size_t value_token) {
+        if (m_document->key_equals(key_token, key))
+        {
+            result = LazyValue{*m_document, value_token};
+            return false;
+        }
+        return true;
+    });
+    return result;
+}
+
+inline LazyValue
+LazyValue::operator[](std::string_view key) const
+{
+    if (auto result = find_field(key))
+    {
+        return *result;
+    }
+    throw std::out_of_range("LazyValue: no member " + std::string(key));
+}
+
+inline LazyObject
+LazyValue::as_object() const
+{
+    size_t n_fields = 0;
+    m_document->for_each_field(m_token, [&](size_t, size_t) {
+        ++n_fields;
+        return true;
+    });
+    auto  *fields = m_document->m_arena.allocate_array<json_detail::lazy_field>(n_fields);
+    size_t i      = 0;
+    m_document->for_each_field(m_token, [&](size_t key_token, size_t value_token) {
+        std::string_view key = m_document->raw_key(key_token);
+        if (std::memchr(key.data(), '\\', key.size()) != nullptr)
+        {
+            JSONReader reader = m_document->reader_at(key_token);
+            reader.next();
+            key = m_document->keep(reader.string_value());
+        }
+        fields[i++] = json_detail::lazy_field{key, value_token};
+        return true;
+    });
+    return LazyObject{*m_document, fields, n_fields};
+}
+
+inline LazyArray
+LazyValue::as_array() const
+{
+    // collected in a buffer first, which saves a second walk over the elements to count them
+    std::vector<size_t> &scratch = m_document->m_scratch;
+    scratch.clear();
+    m_document->for_each_element(m_token, [&](size_t token) { scratch.push_back(token); });
+    auto *element_tokens = m_document->m_arena.allocate_array<size_t>(scratch.size());
+    std::copy(scratch.begin(), scratch.end(), element_tokens);
+    return LazyArray{*m_document, element_tokens, scratch.size()};
+}
+
+inline std::string_view
+LazyValue::as_string() const
+{
+    JSONReader reader = m_document->reader_at(m_token);
+    if (reader.next() != JSONEvent::string)
+    {
+        m_document->error("expected a string", m_token);
+    }
+    return m_document->keep(reader.string_value());
+}
+
+inline bool
+LazyValue::is_null() const
+{
+    JSONReader reader = m_document->reader_at(m_token);
+    return reader.next() == JSONEvent::null;
+}
+
+template <typename T>
+T
+LazyValue::get() const
+{
+    JSONReader reader = m_document->reader_at(m_token);
+    T          value{};
+    deserialize(reader, value);
+    return value;
+}
+
+#endif // BOQ_JSON_DOCUMENT_H
@@ -0,0 +1,202 @@
+#ifndef BOQ_JSON_ESCAPE_H
+#define BOQ_JSON_ESCAPE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#if (defined(__x86_64__) || defined(_M_X64)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define BOQ_JSON_ESCAPE_X86
+#endif
+
+/// Escaping of JSON string contents. Quotes, backslashes and control characters (< 0x20) have to be escaped, all other
+/// bytes (including UTF-8 multi-byte sequences) are copied as they are. Strings usually contain long runs that don't
+/// need escaping, so the escaper searches for the next byte that needs escaping 16 (SSE2) or 32 (AVX2) bytes at a time
+/// and copies the runs in between to the sink in bulk. The vector width is picked at runtime based on the CPU, other
+/// platforms use the scalar search.
+namespace json_escape
+{
+    /// Signature of the functions returning the index of the first byte in [data, data + size) that needs escaping, or
+    /// size if there is none.
+    using find_escape_fn = size_t (*)(const char *data, size_t size);
+
+    namespace detail
+    {
+        inline constexpr std::array<bool, 256> needs_escape = []() {
+            std::array<bool, 256> table{};
+            for (size_t c = 0; c < 0x20; ++c)
+            {
+                table[c] = true;
+            }
+            table['"']  = true;
+            table['\\'] = true;
+            return table;
+        }();
+
+        constexpr bool
+        needs_escape_char(char c)
+        {
+            return needs_escape[static_cast<unsigned char>(c)];
+        }
+    } // namespace detail
+
+    constexpr size_t
+    find_escape_scalar(const char *data, size_t size)
+    {
+        size_t i = 0;
+        while (i < size && !detail::needs_escape_char(data[i]))
+        {
+            ++i;
+        }
+        return i;
+    }
+
+#ifdef BOQ_JSON_ESCAPE_X86
+
+    inline size_t
+    find_escape_sse2(const char *data, size_t size)
+    {
+        const __m128i quote     = _mm_set1_epi8('"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i max_ctrl  = _mm_set1_epi8(0x1F);
+
+        size_t i = 0;
+        for (; i + 16 <= size; i += 16)
+        {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+            // unsigned chunk <= 0x1F is equivalent to max(chunk, 0x1F) == 0x1F
+            __m128i is_ctrl = _mm_cmpeq_epi8(_mm_max_epu8(chunk, max_ctrl), max_ctrl);
+            __m128i special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+                                           is_ctrl);
+            if (int mask = _mm_movemask_epi8(special); mask != 0)
+            {
+                return i + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+            }
+        }
+        return i + find_escape_scalar(data + i, size - i);
+    }
+
+    __attribute__((target("avx2"))) inline size_t
+    find_escape_avx2(const char *data, size_t size)
+    {
+        const __m256i quote     = _mm256_set1_epi8('"');
+        const __m256i backslash = _mm256_set1_epi8('\\');
+        const __m256i max_ctrl  = _mm256_set1_epi8(0x1F);
+
+        size_t i = 0;
+        for (; i + 32 <= size; i += 32)
+        {
+            __m256i chunk   = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+            __m256i is_ctrl = _mm256_cmpeq_epi8(_mm256_max_epu8(chunk, max_ctrl), max_ctrl);
+            __m256i special = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote), _mm256_cmpeq_epi8(chunk, backslash)), is_ctrl);
+            if (auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(special)); mask != 0)
+            {
+                return i + static_cast<size_t>(__builtin_ctz(mask));
+            }
+        }
+        // the remaining < 32 bytes may still fill an SSE2 chunk
+        return i + find_escape_sse2(data + i, size - i);
+    }
+
+    inline find_escape_fn
+    select_find_escape()
+    {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return find_escape_avx2;
+        }
+        return find_escape_sse2;
+    }
+
+#else
+
+    inline find_escape_fn
+    select_find_escape()
+    {
+        return find_escape_scalar;
+    }
+
+#endif // BOQ_JSON_ESCAPE_X86
+
+    /// Searches with the fastest implementation supported by the CPU.
+    inline size_t
+    find_escape(const char *data, size_t size)
+    {
+        static const find_escape_fn impl = select_find_escape();
+        return impl(data, size);
+    }
+
+    /// Writes the escape sequence for a character that needs escaping.
+    template <typename SINK>
+    constexpr void
+    write_escape_sequence(SINK &sink, char c)
+    {
+        char short_escape = 0;
+        switch (c)
+        {
+        case '"':
+            short_escape = '"';
+            break;
+        case '\\':
+            short_escape = '\\';
+            break;
+        case '\b':
+            short_escape = 'b';
+            break;
+        case '\f':
+            short_escape = 'f';
+            break;
+        case '\n':
+            short_escape = 'n';
+            break;
+        case '\r':
+            short_escape = 'r';
+            break;
+        case '\t':
+            short_escape = 't';
+            break;
+        default:
+            break;
+        }
+        if (short_escape != 0)
+        {
+            const char sequence[2] = {'\\', short_escape};
+            sink.write(sequence, 2);
+        }
+        else
+        {
+            constexpr std::string_view hex_digits = "0123456789abcdef";
+            const auto                 byte       = static_cast<unsigned char>(c);
+            const char sequence[6] = {'\\', 'u', '0', '0', hex_digits[byte >> 4], hex_digits[byte & 0xF]};
+            sink.write(sequence, 6);
+        }
+    }
+
+    /// Writes s to the sink with all characters escaped as required by JSON (without surrounding quotes).
+    /// Can be evaluated at compile time by passing find_escape_scalar.
+    template <typename SINK>
+    constexpr void
+    write_escaped(SINK &sink, std::string_view s, find_escape_fn find = find_escape)
+    {
+        const char *data = s.data();
+        size_t      size = s.size();
+        while (size > 0)
+        {
+            size_t run = find(data, size);
+            sink.write(data, run);
+            if (run == size)
+            {
+                return;
+            }
+            write_escape_sequence(sink, data[run]);
+            data += run + 1;
+            size -= run + 1;
+        }
+    }
+} // namespace json_escape
+
+#endif // BOQ_JSON_ESCAPE_H
@@ -0,0 +1,337 @@
+#ifndef BOQ_JSON_NUMBER_H
+#define BOQ_JSON_NUMBER_H
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <clocale>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+#if defined(__GLIBC__)
+#define BOQ_JSON_NUMBER_STRTOD_L
+#endif
+
+// Conversion of the text of JSON numbers to integers and doubles, the counterpart of the writer's std::to_chars output.
+// Like std::from_chars, it is independent of the locale and doesn't allocate, and doubles are rounded correctly, so
+// the shortest round-trip output of the writer is read back as the same value.
+// The digits are consumed 8 at a time with SWAR (SIMD within a register) arithmetic on a 64 bit word. Integers with up
+// to 19 digits, and doubles whose digits fit in 53 bits with a decimal exponent of at most 22 (exactly representable
+// operands, so one correctly rounded multiplication or division gives the exact result) are converted directly, all
+// other numbers are left to std::from_chars.
+// Numbers too small for a double are rounded to zero, numbers too large are rejected. The from_chars of older standard
+// libraries (libstdc++ before GCC 12) reports subnormal results as out of range, those are converted with strtod_l in
+// the C locale where available, from a copy of the significant digits in a buffer on the stack.
+
+namespace json_number
+{
+    /// Whether the 8 bytes at p are all ASCII digits.
+    inline bool
+    is_eight_digits(const char *p)
+    {
+        uint64_t chunk;
+        std::memcpy(&chunk, p, 8);
+        // the high nibbles of digits are 3, and adding 6 to their low nibbles doesn't carry into the high nibble
+        return ((chunk & 0xf0f0f0f0f0f0f0f0) | (((chunk + 0x0606060606060606) & 0xf0f0f0f0f0f0f0f0) >> 4)) ==
+               0x3333333333333333;
+    }
+
+    /// Value of the 8 ASCII digits at p. The digits are combined pairwise in three multiplications instead of eight.
+    inline uint32_t
+    parse_eight_digits(const char *p)
+    {
+        uint64_t chunk;
+        std::memcpy(&chunk, p, 8);
+        if constexpr (std::endian::native == std::endian::big)
+        {
+            chunk = __builtin_bswap64(chunk);
+        }
+        // the first digit is in the lowest byte
+        chunk -= 0x3030303030303030;
+        chunk = (chunk * 10) + (chunk >> 8); // pairs of digits in the even bytes
+        chunk = (((chunk & 0x000000ff000000ff) * (100 + (1000000ULL << 32))) +
+                 (((chunk >> 16) & 0x000000ff000000ff) * (1 + (10000ULL << 32)))) >>
+                32;
+        return static_cast<uint32_t>(chunk);
+    }
+
+    namespace detail
+    {
+        /// Appends the digits at p to value, advancing p past them, and returns their number. Wraps around after 19
+        /// digits.
+        inline size_t
+        accumulate_digits(const char *&p, const char *end, uint64_t &value)
+        {
+            const char *start = p;
+            while (end - p >= 8 && is_eight_digits(p))
+            {
+                value = value * 100'000'000 + parse_eight_digits(p);
+                p += 8;
+            }
+            while (p != end && *p >= '0' && *p <= '9')
+            {
+                value = value * 10 + static_cast<uint64_t>(*p - '0');
+                ++p;
+            }
+            return static_cast<size_t>(p - start);
+        }
+
+        inline constexpr size_t max_exact_digits = 19; // any 19 digit number fits in 64 bits
+
+        inline constexpr double powers_of_10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                                  1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                                  1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+        /// Whether the text starts like a JSON number, from_chars would accept inf and nan as well.
+        inline bool
+        starts_with_digit(std::string_view text)
+        {
+            size_t i = !text.empty() && text[0] == '-' ? 1 : 0;
+            return i < text.size() && text[i] >= '0' && text[i] <= '9';
+        }
+
+        template <typename T>
+        bool
+        parse_with_from_chars(std::string_view text, T &value)
+        {
+            const char *end    = text.data() + text.size();
+            auto [last, error] = std::from_chars(text.data(), end, value);
+            return error == std::errc{} && last == end;
+        }
+
+        /// Writes the number in text, which std::from_chars accepted, to buffer as <sign><digits>e<exponent> with at
+        /// most max_digits significant digits, and returns the size. When nonzero digits are cut off, a 1 is appended
+        /// instead, which rounds the same: at most 767 significant digits can decide the rounding of a double.
+        /// order is set to the decimal order of magnitude, the value is in [10^(order - 1), 10^order).
+        inline constexpr size_t max_significant_digits = 800;
+
+        inline size_t
+        write_significant_prefix(std::string_view text, char *buffer, int64_t &order)
+        {
+            const char *p        = text.data();
+            const char *end      = p + text.size();
+            size_t      size     = 0;
+            size_t      n_digits = 0;
+            int64_t     exponent = 0; // the value is <digits in buffer> * 10^exponent
+            bool        cut_off  = false;
+            if (*p == '-')
+            {
+                buffer[size++] = *p++;
+            }
+            auto append = [&](char digit, bool is_fraction) {
+                if (n_digits == 0 && digit == '0')
+                {
+                    exponent -= is_fraction; // leading zero
+                }
+                else if (n_digits < max_significant_digits)
+                {
+                    buffer[size++] = digit;
+                    ++n_digits;
+                    exponent -= is_fraction;
+                }
+                else
+                {
+                    cut_off |= digit != '0';
+                    exponent += !is_fraction;
+                }
+            };
+            for (; p != end && *p >= '0' && *p <= '9'; ++p)
+            {
+                append(*p, false);
+            }
+            if (p != end && *p == '.')
+            {
+                for (++p; p != end && *p >= '0' && *p <= '9'; ++p)
+                {
+                    append(*p, true);
+                }
+            }
+            if (cut_off)
+            {
+                buffer[size++] = '1';
+                ++n_digits;
+                --exponent;
+            }
+            if (p != end && (*p == 'e' || *p == 'E'))
+            {
+                ++p;
+                bool negative_exponent = *p == '-';
+                p += *p == '-' || *p == '+';
+                // saturates, anything beyond is far out of the range of a double anyway
+                int64_t explicit_exponent = 0;
+                for (; p != end; ++p)
+                {
+                    explicit_exponent = std::min<int64_t>(explicit_exponent * 10 + (*p - '0'), 1'000'000'000);
+                }
+                exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+            }
+            if (n_digits == 0)
+            {
+                buffer[size++] = '0';
+                exponent       = 0;
+            }
+            order    = n_digits == 0 ? 0 : exponent + static_cast<int64_t>(n_digits);
+            exponent = std::clamp<int64_t>(exponent, -100'000, 100'000);
+
+            buffer[size++] = 'e';
+            size           = static_cast<size_t>(std::to_chars(buffer + size, buffer + size + 8, exponent).ptr - buffer);
+            buffer[size]   = '\0';
+            return size;
+        }
+
+        inline bool
+        parse_double_slow(std::string_view text, double &value)
+        {
+            const char *end    = text.data() + text.size();
+            auto [last, error] = std::from_chars(text.data(), end, value);
+            if (last != end || error == std::errc{})
+            {
+                return last == end;
+            }
+            // the whole text is a number, but too large, too small or subnormal
+            char    buffer[max_significant_digits + 16];
+            int64_t order = 0;
+            write_significant_prefix(text, buffer, order);
+#ifdef BOQ_JSON_NUMBER_STRTOD_L
+            // the from_chars of older standard libraries rejects subnormal results
+            static const locale_t c_locale = newlocale(LC_ALL_MASK, "C", locale_t{});
+            double                d        = strtod_l(buffer, nullptr, c_locale);
+            if (std::isfinite(d))
+            {
+                // 0 if the value underflows, with the sign of the number
+                value = d;
+                return true;
+            }
+            return false;
+#else
+            if (order <= 0)
+            {
+                // too small for a double, rounds to zero
+                value = text[0] == '-' ? -0.0 : 0.0;
+                return true;
+            }
+            return false;
+#endif
+        }
+    } // namespace detail
+
+    /// Converts the text of an integer. Returns false if it isn't an integer or out of the range of T.
+    template <std::integral T>
+        requires(!std::is_same_v<T, bool> && sizeof(T) <= sizeof(uint64_t))
+    bool
+    parse(std::string_view text, T &value)
+    {
+        const char *p        = text.data();
+        const char *end      = p + text.size();
+        bool        negative = p != end && *p == '-';
+        if (negative && std::is_unsigned_v<T>)
+        {
+            return false;
+        }
+        p += negative;
+
+        uint64_t magnitude = 0;
+        size_t   n_digits  = detail::accumulate_digits(p, end, magnitude);
+        if (n_digits == 0 || p != end)
+        {
+            return false;
+        }
+        if (n_digits > detail::max_exact_digits)
+        {
+            // may have overflowed (or has leading zeros)
+            return detail::parse_with_from_chars(text, value);
+        }
+        uint64_t limit = std::numeric_limits<T>::max();
+        if (magnitude > limit + (negative ? 1u : 0u))
+        {
+            return false;
+        }
+        uint64_t bits = negative ? 0 - magnitude : magnitude;
+        if constexpr (std::is_same_v<T, uint64_t>)
+        {
+            value = bits;
+        }
+        else
+        {
+            value = static_cast<T>(bits);
+        }
+        return true;
+    }
+
+    /// Converts the text of a number to the nearest double. Returns false if it isn't a number or too large for a double.
+    inline bool
+    parse(std::string_view text, double &value)
+    {
+        if (!detail::starts_with_digit(text))
+        {
+            return false;
+        }
+        const char *p        = text.data();
+        const char *end      = p + text.size();
+        bool        negative = *p == '-';
+        p += negative;
+
+        uint64_t mantissa = 0;
+        size_t   n_digits = detail::accumulate_digits(p, end, mantissa);
+        int64_t  exponent = 0;
+        if (p != end && *p == '.')
+        {
+            ++p;
+            size_t n_fraction_digits = detail::accumulate_digits(p, end, mantissa);
+            if (n_fraction_digits == 0)
+            {
+                return false;
+            }
+            n_digits += n_fraction_digits;
+            exponent = -static_cast<int64_t>(n_fraction_digits);
+        }
+        if (p != end && (*p == 'e' || *p == 'E'))
+        {
+            ++p;
+            bool negative_exponent = p != end && *p == '-';
+            p += p != end && (*p == '-' || *p == '+');
+            uint64_t explicit_exponent = 0;
+            size_t   n_exponent_digits = detail::accumulate_digits(p, end, explicit_exponent);
+            if (n_exponent_digits == 0)
+            {
+                return false;
+            }
+            if (n_exponent_digits > 4)
+            {
+                return detail::parse_double_slow(text, value);
+            }
+            exponent += negative_exponent ? -static_cast<int64_t>(explicit_exponent)
+                                          : static_cast<int64_t>(explicit_exponent);
+        }
+        constexpr uint64_t max_exact_mantissa = uint64_t{1} << std::numeric_limits<double>::digits;
+        if (p == end && n_digits <= detail::max_exact_digits && mantissa <= max_exact_mantissa && exponent >= -22 &&
+            exponent <= 22)
+        {
+            auto   d = static_cast<double>(mantissa);
+            size_t e = static_cast<size_t>(exponent < 0 ? -exponent : exponent);
+            d        = exponent < 0 ? d / detail::powers_of_10[e] : d * detail::powers_of_10[e];
+            value    = negative ? -d : d;
+            return true;
+        }
+        return detail::parse_double_slow(text, value);
+    }
+
+    /// Other floating point types are converted by std::from_chars.
+    template <std::floating_point T>
+        requires(!std::is_same_v<T, double>)
+    bool
+    parse(std::string_view text, T &value)
+    {
+        return detail::starts_with_digit(text) && detail::parse_with_from_chars(text, value);
+    }
+} // namespace json_number
+
+#endif // BOQ_JSON_NUMBER_H
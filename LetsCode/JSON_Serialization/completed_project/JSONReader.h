@@ -0,0 +1,665 @@
+#ifndef BOQ_JSON_READER_H
+#define BOQ_JSON_READER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "JSONEscape.h"
+#include "JSONStructuralIndex.h"
+
+/// Thrown by the JSONReader when the input isn't valid JSON. offset is the position in the input where the error was
+/// detected.
+class JSONParseError : public std::runtime_error
+{
+  public:
+    JSONParseError(const std::string &message, size_t offset)
+        : std::runtime_error(message + " at offset " + std::to_string(offset)), m_offset(offset)
+    {
+    }
+
+    size_t
+    offset() const
+    {
+        return m_offset;
+    }
+
+  private:
+    size_t m_offset;
+};
+
+/// The events produced by the JSONReader, in document order.
+enum class JSONEvent
+{
+    begin_object,
+    end_object,
+    begin_array,
+    end_array,
+    key,
+    string,
+    number,
+    boolean,
+    null,
+    end_of_input,
+};
+
+/// Concept for the handlers receiving the events of JSONReader::parse. The string_views passed to key, string and
+/// number are only valid during the call.
+template <typename T>
+concept JSONHandler = requires(T handler, std::string_view s, bool b) {
+    handler.begin_object();
+    handler.end_object();
+    handler.begin_array();
+    handler.end_array();
+    handler.key(s);
+    handler.string(s);
+    handler.number(s);
+    handler.boolean(b);
+    handler.null();
+};
+
+/// Streaming (SAX style) JSON parser. The reader doesn't build a document, it reports the structure of the input as a
+/// sequence of events, either pulled one at a time with next() or pushed to a handler with parse():
+///
+///   JSONReader reader{R"({ "name" : "Bob", "list" : [ 1, 2 ] })"};
+///   reader.next(); // begin_object
+///   reader.next(); // key, reader.string_value() == "name"
+///   reader.next(); // string, reader.string_value() == "Bob"
+///   ...
+///
+/// Strings are zero-copy: when a key or string value contains no escape sequences, string_value() is a view into the
+/// input. Otherwise it is decoded into a buffer of the reader, and only valid until the next call to next() or peek().
+/// Numbers are reported as their text, validated against the JSON grammar. The input has to outlive the reader.
+/// Malformed input throws a JSONParseError.
+///
+/// For large inputs, build a StructuralIndex first (see JSONStructuralIndex.h) and pass it to the reader: the reader
+/// then jumps from token to token instead of scanning the whitespace between them.
+class JSONReader
+{
+  public:
+    explicit JSONReader(std::string_view input) : m_input(input)
+    {
+    }
+
+    /// Reads the input by walking the token positions of its structural index, which has to be built from the same
+    /// input. The index has to outlive the reader.
+    JSONReader(std::string_view input, const StructuralIndex &index) : JSONReader(input)
+    {
+        m_next_token = index.begin();
+        m_last_token = index.end();
+    }
+
+    /// Advances to the next event. After the top-level value has been read, returns end_of_input (repeatedly).
+    JSONEvent
+    next()
+    {
+        if (m_has_peeked)
+        {
+            m_has_peeked = false;
+            return m_peeked;
+        }
+        return read_event();
+    }
+
+    /// Returns the next event without consuming it, string_value() and bool_value() already refer to it.
+    JSONEvent
+    peek()
+    {
+        if (!m_has_peeked)
+        {
+            m_peeked     = read_event();
+            m_has_peeked = true;
+        }
+        return m_peeked;
+    }
+
+    /// Skips the next value, including everything nested in it.
+    void
+    skip_value()
+    {
+        size_t depth = 0;
+        do
+        {
+            switch (next())
+            {
+            case JSONEvent::begin_object:
+            case JSONEvent::begin_array:
+                ++depth;
+                break;
+            case JSONEvent::end_object:
+            case JSONEvent::end_array:
+                if (depth == 0)
+                {
+                    error("expected a value");
+                }
+                --depth;
+                break;
+            case JSONEvent::key:
+                if (depth == 0)
+                {
+                    error("expected a value");
+                }
+                break;
+            case JSONEvent::end_of_input:
+                error("expected a value");
+            default:
+                break;
+            }
+        } while (depth > 0);
+    }
+
+    /// The text of the last key, string or number event.
+    std::string_view
+    string_value() const
+    {
+        return m_value;
+    }
+
+    /// The value of the last boolean event.
+    bool
+    bool_value() const
+    {
+        return m_bool;
+    }
+
+    /// Position in the input up to which it has been parsed.
+    size_t
+    offset() const
+    {
+        return m_pos;
+    }
+
+    /// Reads all remaining events and passes them to the handler.
+    template <JSONHandler HANDLER>
+    void
+    parse(HANDLER &handler)
+    {
+        while (true)
+        {
+            switch (next())
+            {
+            case JSONEvent::begin_object:
+                handler.begin_object();
+                break;
+            case JSONEvent::end_object:
+                handler.end_object();
+                break;
+            case JSONEvent::begin_array:
+                handler.begin_array();
+                break;
+            case JSONEvent::end_array:
+                handler.end_array();
+                break;
+            case JSONEvent::key:
+                handler.key(m_value);
+                break;
+            case JSONEvent::string:
+                handler.string(m_value);
+                break;
+            case JSONEvent::number:
+                handler.number(m_value);
+                break;
+            case JSONEvent::boolean:
+                handler.boolean(m_bool);
+                break;
+            case JSONEvent::null:
+                handler.null();
+                break;
+            case JSONEvent::end_of_input:
+                return;
+            }
+        }
+    }
+
+  private:
+    enum class container : uint8_t
+    {
+        object,
+        array,
+    };
+
+    /// What the parser expects next
+    enum class state : uint8_t
+    {
+        value,            // the top-level value, a value in an array after ',' or a value after a key
+        value_or_end,     // after '['
+        key,              // after ',' in an object
+        key_or_end,       // after '{'
+        separator_or_end, // after a value in an object or array
+        done,             // after the top-level value
+    };
+
+    std::string_view       m_input;
+    size_t                 m_pos   = 0;
+    state                  m_state = state::value;
+    std::vector<container> m_nesting;
+    std::string_view       m_value;
+    bool                   m_bool = false;
+    std::string            m_unescaped;
+    JSONEvent              m_peeked     = JSONEvent::end_of_input;
+    bool                   m_has_peeked = false;
+    const uint32_t        *m_next_token = nullptr;
+    const uint32_t        *m_last_token = nullptr;
+
+    [[noreturn]] void
+    error(const char *message) const
+    {
+        throw JSONParseError(message, m_pos);
+    }
+
+    JSONEvent
+    read_event()
+    {
+        while (true)
+        {
+            next_token();
+            if (m_state == state::done)
+            {
+                if (m_pos != m_input.size())
+                {
+                    error("unexpected data after the top-level value");
+                }
+                return JSONEvent::end_of_input;
+            }
+            if (m_pos == m_input.size())
+            {
+                error("unexpected end of input");
+            }
+
+            char c = m_input[m_pos];
+            switch (m_state)
+            {
+            case state::key_or_end:
+                if (c == '}')
+                {
+                    ++m_pos;
+                    return close(container::object);
+                }
+                return read_key();
+            case state::key:
+                return read_key();
+            case state::value_or_end:
+                if (c == ']')
+                {
+                    ++m_pos;
+                    return close(container::array);
+                }
+                return read_value();
+            case state::value:
+                return read_value();
+            case state::separator_or_end:
+                ++m_pos;
+                if (c == ',')
+                {
+                    m_state = m_nesting.back() == container::object ? state::key : state::value;
+                    continue;
+                }
+                if (c == '}' || c == ']')
+                {
+                    return close(c == '}' ? container::object : container::array);
+                }
+                --m_pos;
+                error("expected ',' or the end of the object or array");
+            case state::done:
+                break;
+            }
+        }
+    }
+
+    /// Moves to the next token: to the next position of the structural index if there is one, otherwise past the
+    /// whitespace.
+    void
+    next_token()
+    {
+        if (m_next_token != nullptr)
+        {
+            m_pos = m_next_token != m_last_token ? *m_next_token++ : m_input.size();
+            return;
+        }
+        while (m_pos < m_input.size())
+        {
+            char c = m_input[m_pos];
+            if (c != ' ' && c != '\n' && c != '\r' && c != '\t')
+            {
+                return;
+            }
+            ++m_pos;
+        }
+    }
+
+    JSONEvent
+    open(container type, state next_state)
+    {
+        ++m_pos;
+        m_nesting.push_back(type);
+        m_state = next_state;
+        return type == container::object ? JSONEvent::begin_object : JSONEvent::begin_array;
+    }
+
+    JSONEvent
+    close(container type)
+    {
+        if (m_nesting.back() != type)
+        {
+            --m_pos;
+            error(type == container::object ? "unexpected '}' in array" : "unexpected ']' in object");
+        }
+        m_nesting.pop_back();
+        end_value();
+        return type == container::object ? JSONEvent::end_object : JSONEvent::end_array;
+    }
+
+    /// Updates the state after a complete value
+    void
+    end_value()
+    {
+        m_state = m_nesting.empty() ? state::done : state::separator_or_end;
+    }
+
+    JSONEvent
+    read_key()
+    {
+        if (m_input[m_pos] != '"')
+        {
+            error("expected a string as object key");
+        }
+        read_string();
+        next_token();
+        if (m_pos == m_input.size() || m_input[m_pos] != ':')
+        {
+            error("expected ':' after object key");
+        }
+        ++m_pos;
+        m_state = state::value;
+        return JSONEvent::key;
+    }
+
+    JSONEvent
+    read_value()
+    {
+        switch (m_input[m_pos])
+        {
+        case '{':
+            return open(container::object, state::key_or_end);
+        case '[':
+            return open(container::array, state::value_or_end);
+        case '"':
+            read_string();
+            end_value();
+            return JSONEvent::string;
+        case 't':
+            read_literal("true");
+            m_bool = true;
+            return JSONEvent::boolean;
+        case 'f':
+            read_literal("false");
+            m_bool = false;
+            return JSONEvent::boolean;
+        case 'n':
+            read_literal("null");
+            return JSONEvent::null;
+        default:
+            read_number();
+            return JSONEvent::number;
+        }
+    }
+
+    void
+    read_literal(std::string_view literal)
+    {
+        if (m_input.substr(m_pos, literal.size()) != literal)
+        {
+            error("invalid literal");
+        }
+        m_pos += literal.size();
+        check_scalar_end("invalid literal");
+        end_value();
+    }
+
+    /// A scalar has to be followed by whitespace, an operator or the end of the input. The structural index only has
+    /// the position of the first byte of a scalar, so garbage after it would otherwise be skipped.
+    void
+    check_scalar_end(const char *message) const
+    {
+        if (m_pos == m_input.size())
+        {
+            return;
+        }
+        switch (m_input[m_pos])
+        {
+        case ' ':
+        case '\n':
+        case '\r':
+        case '\t':
+        case ',':
+        case ':':
+        case ']':
+        case '}':
+            return;
+        default:
+            error(message);
+        }
+    }
+
+    /// Validates the number against the JSON grammar: -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+    void
+    read_number()
+    {
+        size_t start       = m_pos;
+        auto   peek        = [this]() { return m_pos < m_input.size() ? m_input[m_pos] : '\0'; };
+        auto   is_digit    = [](char c) { return c >= '0' && c <= '9'; };
+        auto   read_digits = [&]() {
+            if (!is_digit(peek()))
+            {
+                error("invalid number");
+            }
+            while (is_digit(peek()))
+            {
+                ++m_pos;
+            }
+        };
+
+        if (peek() == '-')
+        {
+            ++m_pos;
+        }
+        if (peek() == '0')
+        {
+            // no leading zeros
+            ++m_pos;
+        }
+        else
+        {
+            read_digits();
+        }
+        if (peek() == '.')
+        {
+            ++m_pos;
+            read_digits();
+        }
+        if (peek() == 'e' || peek() == 'E')
+        {
+            ++m_pos;
+            if (peek() == '+' || peek() == '-')
+            {
+                ++m_pos;
+            }
+            read_digits();
+        }
+        m_value = m_input.substr(start, m_pos - start);
+        check_scalar_end("invalid number");
+        end_value();
+    }
+
+    /// Reads the string starting at the opening quote at the current position into m_value. Searches for the closing
+    /// quote with the same vectorized search as the writer's escaping, which stops at quotes, backslashes and control
+    /// characters.
+    void
+    read_string()
+    {
+        size_t start = ++m_pos;
+        m_pos += json_escape::find_escape(m_input.data() + m_pos, m_input.size() - m_pos);
+        if (m_pos < m_input.size() && m_input[m_pos] == '"')
+        {
+            // no escape sequences, the value is a view into the input
+            m_value = m_input.substr(start, m_pos - start);
+            ++m_pos;
+            return;
+        }
+
+        m_unescaped.assign(m_input.data() + start, m_pos - start);
+        while (true)
+        {
+            if (m_pos == m_input.size())
+            {
+                error("unterminated string");
+            }
+            char c = m_input[m_pos];
+            if (c == '"')
+            {
+                ++m_pos;
+                m_value = m_unescaped;
+                return;
+            }
+            if (c != '\\')
+            {
+                error("unescaped control character in string");
+            }
+            ++m_pos;
+            read_escape_sequence();
+
+            size_t run = json_escape::find_escape(m_input.data() + m_pos, m_input.size() - m_pos);
+            m_unescaped.append(m_input.data() + m_pos, run);
+            m_pos += run;
+        }
+    }
+
+    /// Decodes the escape sequence after a backslash and appends it to m_unescaped.
+    void
+    read_escape_sequence()
+    {
+        if (m_pos == m_input.size())
+        {
+            error("unterminated string");
+        }
+        char c = m_input[m_pos++];
+        switch (c)
+        {
+        case '"':
+        case '\\':
+        case '/':
+            m_unescaped += c;
+            return;
+        case 'b':
+            m_unescaped += '\b';
+            return;
+        case 'f':
+            m_unescaped += '\f';
+            return;
+        case 'n':
+            m_unescaped += '\n';
+            return;
+        case 'r':
+            m_unescaped += '\r';
+            return;
+        case 't':
+            m_unescaped += '\t';
+            return;
+        case 'u':
+            break;
+        default:
+            --m_pos;
+            error("invalid escape sequence");
+        }
+
+        uint32_t code_point = read_hex4();
+        if (code_point >= 0xD800 && code_point <= 0xDBFF)
+        {
+            // high surrogate, has to be followed by an escaped low surrogate
+            if (m_input.substr(m_pos, 2) != "\\u")
+            {
+                error("unpaired surrogate in string");
+            }
+            m_pos += 2;
+            uint32_t low = read_hex4();
+            if (low < 0xDC00 || low > 0xDFFF)
+            {
+                error("unpaired surrogate in string");
+            }
+            code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+        }
+        else if (code_point >= 0xDC00 && code_point <= 0xDFFF)
+        {
+            error("unpaired surrogate in string");
+        }
+        append_utf8(code_point);
+    }
+
+    uint32_t
+    read_hex4()
+    {
+        if (m_input.size() - m_pos < 4)
+        {
+            error("invalid \\u escape sequence");
+        }
+        uint32_t value = 0;
+        for (size_t i = 0; i < 4; ++i)
+        {
+            char     c = m_input[m_pos + i];
+            uint32_t digit;
+            if (c >= '0' && c <= '9')
+            {
+                digit = static_cast<uint32_t>(c - '0');
+            }
+            else if (c >= 'a' && c <= 'f')
+            {
+                digit = static_cast<uint32_t>(c - 'a' + 10);
+            }
+            else if (c >= 'A' && c <= 'F')
+            {
+                digit = static_cast<uint32_t>(c - 'A' + 10);
+            }
+            else
+            {
+                error("invalid \\u escape sequence");
+            }
+            value = value * 16 + digit;
+        }
+        m_pos += 4;
+        return value;
+    }
+
+    void
+    append_utf8(uint32_t code_point)
+    {
+        auto byte = [](uint32_t b) { return static_cast<char>(static_cast<unsigned char>(b)); };
+        if (code_point < 0x80)
+        {
+            m_unescaped += byte(code_point);
+        }
+        else if (code_point < 0x800)
+        {
+            m_unescaped += byte(0xC0 | (code_point >> 6));
+            m_unescaped += byte(0x80 | (code_point & 0x3F));
+        }
+        else if (code_point < 0x10000)
+        {
+            m_unescaped += byte(0xE0 | (code_point >> 12));
+            m_unescaped += byte(0x80 | ((code_point >> 6) & 0x3F));
+            m_unescaped += byte(0x80 | (code_point & 0x3F));
+        }
+        else
+        {
+            m_unescaped += byte(0xF0 | (code_point >> 18));
+            m_unescaped += byte(0x80 | ((code_point >> 12) & 0x3F));
+            m_unescaped += byte(0x80 | ((code_point >> 6) & 0x3F));
+            m_unescaped += byte(0x80 | (code_point & 0x3F));
+        }
+    }
+};
+
+#endif // BOQ_JSON_READER_H
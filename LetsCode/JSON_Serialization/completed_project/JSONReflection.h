@@ -0,0 +1,193 @@
+#ifndef BOQ_JSON_REFLECTION_H
+#define BOQ_JSON_REFLECTION_H
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "FixedString.h"
+#include "JSONEscape.h"
+#include "OutputSinks.h"
+
+// Declarative serialization: instead of writing a serialize overload, a type lists its fields as (name, member pointer)
+// pairs by specializing json_fields:
+//
+//   template <>
+//   struct json_fields<Address>
+//   {
+//       static constexpr std::tuple value{field<"street_name", &Address::street_name>{},
+//                                         field<"house_number", &Address::house_number>{}};
+//   };
+//
+// From this table the JSONWriter generates a serializer at compile time. The type is flattened into its leaf values
+// (members that are not reflected themselves, like strings, numbers and lists) and the constant text in between,
+// which includes braces, separators and quoted keys of nested objects, is merged into one fragment per gap:
+//   { "name" : <name>, "address" : { "street_name" : <street_name>, "house_number" : <house_number> } }
+// is written as 4 constant fragments and 3 values.
+
+/// A field of a reflected type: its JSON key and a pointer to the data member.
+template <fixed_string NAME, auto MEMBER>
+struct field
+{
+    static constexpr std::string_view name   = NAME.view();
+    static constexpr auto             member = MEMBER;
+};
+
+/// Specialize with a static constexpr std::tuple of fields named value to make a type serializable.
+template <typename T>
+struct json_fields;
+
+template <typename T>
+concept JSONReflected = requires { json_fields<T>::value; };
+
+namespace json_detail
+{
+    template <typename MEMBER_PTR>
+    struct member_type;
+
+    template <typename M, typename C>
+    struct member_type<M C::*>
+    {
+        using type = M;
+    };
+
+    template <typename FIELD>
+    using field_type_t = typename member_type<std::remove_cv_t<decltype(FIELD::member)>>::type;
+
+    template <typename T>
+    using fields_t = std::remove_cv_t<decltype(json_fields<T>::value)>;
+
+    /// A leaf value reached from the serialized object through a chain of member pointers.
+    template <auto... MEMBERS>
+    struct leaf_path
+    {
+        template <typename T>
+        static const auto &
+        get(const T &obj)
+        {
+            return (obj.*....*MEMBERS);
+        }
+    };
+
+    template <typename FIELDS, auto... PREFIX>
+    struct leaves_of_fields;
+
+    template <typename FIELD, auto... PREFIX>
+    struct leaves_of_field
+    {
+        using type = std::tuple<leaf_path<PREFIX..., FIELD::member>>;
+    };
+
+    template <typename FIELD, auto... PREFIX>
+        requires JSONReflected<field_type_t<FIELD>>
+    struct leaves_of_field<FIELD, PREFIX...>
+    {
+        using type = typename leaves_of_fields<fields_t<field_type_t<FIELD>>, PREFIX..., FIELD::member>::type;
+    };
+
+    template <typename... FIELDS, auto... PREFIX>
+    struct leaves_of_fields<std::tuple<FIELDS...>, PREFIX...>
+    {
+        using type = decltype(std::tuple_cat(std::declval<typename leaves_of_field<FIELDS, PREFIX...>::type>()...));
+    };
+
+    /// Walks the JSON output of T, passing the constant text to the sink and calling leaf() for every leaf value.
+    template <typename T, typename PLAN_SINK>
+    constexpr void
+    visit_plan(PLAN_SINK &sink)
+    {
+        sink.write("{ ", 2);
+        std::apply(
+            [&sink]<typename... FIELDS>(FIELDS...) {
+                bool is_first = true;
+                auto visit_field = [&sink, &is_first]<typename FIELD>() {
+                    if (!is_first)
+                    {
+                        sink.write(", ", 2);
+                    }
+                    is_first = false;
+                    sink.put('"');
+                    json_escape::write_escaped(sink, FIELD::name, json_escape::find_escape_scalar);
+                    sink.write("\" : ", 4);
+                    if constexpr (JSONReflected<field_type_t<FIELD>>)
+                    {
+                        visit_plan<field_type_t<FIELD>>(sink);
+                    }
+                    else
+                    {
+                        sink.leaf();
+                    }
+                };
+                (visit_field.template operator()<FIELDS>(), ...);
+            },
+            json_fields<T>::value);
+        sink.write(" }", 2);
+    }
+
+    struct plan_counter : counting_sink
+    {
+        size_t n_leaves = 0;
+
+        constexpr void
+        leaf()
+        {
+            ++n_leaves;
+        }
+    };
+
+    /// Collects the text in one array, offsets[i] is the start of the fragment before leaf i.
+    template <size_t text_size, size_t n_leaves>
+    struct plan_builder : array_sink
+    {
+        std::array<char, text_size>        text{};
+        std::array<size_t, n_leaves + 2>   offsets{};
+        size_t                             leaf_index = 0;
+
+        constexpr plan_builder() : array_sink{nullptr}
+        {
+        }
+
+        constexpr void
+        leaf()
+        {
+            offsets[++leaf_index] = static_cast<size_t>(out - text.data());
+        }
+    };
+
+    /// The generated serializer of a reflected type: the leaves, and the constant fragments before, between and after
+    /// them.
+    template <typename T>
+    struct serializer_plan
+    {
+        using leaves                    = typename leaves_of_fields<fields_t<T>>::type;
+        static constexpr size_t n_leaves = std::tuple_size_v<leaves>;
+
+      private:
+        static constexpr plan_counter counts = []() {
+            plan_counter counter;
+            visit_plan<T>(counter);
+            return counter;
+        }();
+
+        static constexpr auto built = []() {
+            plan_builder<counts.size, n_leaves> builder;
+            builder.out = builder.text.data();
+            visit_plan<T>(builder);
+            builder.offsets[n_leaves + 1] = counts.size;
+            return std::pair{builder.text, builder.offsets};
+        }();
+
+      public:
+        /// fragment(i) is the constant text before leaf i, fragment(n_leaves) the text after the last leaf
+        static constexpr std::string_view
+        fragment(size_t i)
+        {
+            return {built.first.data() + built.second[i], built.second[i + 1] - built.second[i]};
+        }
+    };
+} // namespace json_detail
+
+#endif // BOQ_JSON_REFLECTION_H
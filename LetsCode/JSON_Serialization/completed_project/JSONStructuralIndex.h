@@ -0,0 +1,370 @@
+#ifndef BOQ_JSON_STRUCTURAL_INDEX_H
+#define BOQ_JSON_STRUCTURAL_INDEX_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+
+#if (defined(__x86_64__) || defined(_M_X64)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define BOQ_JSON_INDEX_X86
+#endif
+
+/// Stage 1 of the two-stage JSON parsing: finds the positions of all tokens in the input without parsing it. The
+/// input is processed in blocks of 64 bytes. Each block is first classified with SIMD compares into one bit mask per
+/// character class (quotes, backslashes, the operators {}[]:, and whitespace), and the bit masks are then combined
+/// with branchless bit operations into the token positions:
+///  - escaped characters are found from the runs of backslashes (a character is escaped by an odd-length run)
+///  - the unescaped quotes delimit the strings, the prefix xor of their mask marks the bytes inside strings
+///  - the tokens are the operators outside strings, the opening quotes of strings and the first byte of every scalar
+///    (number, true, false, null)
+/// The quote and scalar state is carried from one block to the next. The positions are written to a tape, which
+/// stage 2 (JSONReader) walks instead of scanning the input byte by byte.
+/// The classification width (SSE2 or AVX2) is picked at runtime based on the CPU, other platforms use a scalar
+/// implementation.
+namespace json_index
+{
+    constexpr size_t block_size = 64;
+
+    /// The characters of a block, one bit per byte.
+    struct block_masks
+    {
+        uint64_t quote;
+        uint64_t backslash;
+        uint64_t op;
+        uint64_t whitespace;
+    };
+
+    /// Signature of the functions classifying n_blocks * 64 bytes at data.
+    using classify_fn = void (*)(const char *data, size_t n_blocks, block_masks *masks);
+
+    namespace detail
+    {
+        enum char_class : uint8_t
+        {
+            quote_class      = 1,
+            backslash_class  = 2,
+            op_class         = 4,
+            whitespace_class = 8,
+        };
+
+        inline constexpr std::array<uint8_t, 256> char_classes = []() {
+            std::array<uint8_t, 256> table{};
+            table['"']  = quote_class;
+            table['\\'] = backslash_class;
+            for (char c : std::string_view("{}[]:,"))
+            {
+                table[static_cast<unsigned char>(c)] = op_class;
+            }
+            for (char c : std::string_view(" \t\n\r"))
+            {
+                table[static_cast<unsigned char>(c)] = whitespace_class;
+            }
+            return table;
+        }();
+
+        /// Marks the characters escaped by a backslash. prev_escaped carries a pending escape into the next block.
+        inline uint64_t
+        find_escaped(uint64_t backslash, uint64_t &prev_escaped)
+        {
+            constexpr uint64_t even_bits = 0x5555555555555555;
+
+            // a backslash escaped by the previous block doesn't start a run
+            backslash &= ~prev_escaped;
+            uint64_t follows_escape      = backslash << 1 | prev_escaped;
+            uint64_t odd_sequence_starts = backslash & ~even_bits & ~follows_escape;
+            uint64_t sequences_starting_on_even_bits;
+            // adding a run's start to the run carries through the run, the carry lands right after it
+            prev_escaped = __builtin_add_overflow(odd_sequence_starts, backslash, &sequences_starting_on_even_bits);
+            uint64_t invert_mask = sequences_starting_on_even_bits << 1;
+            return (even_bits ^ invert_mask) & follows_escape;
+        }
+
+        /// Bit i of the result is the xor of the bits 0..i of x.
+        inline uint64_t
+        prefix_xor(uint64_t x)
+        {
+            x ^= x << 1;
+            x ^= x << 2;
+            x ^= x << 4;
+            x ^= x << 8;
+            x ^= x << 16;
+            x ^= x << 32;
+            return x;
+        }
+    } // namespace detail
+
+    inline void
+    classify_scalar(const char *data, size_t n_blocks, block_masks *masks)
+    {
+        for (size_t block = 0; block < n_blocks; ++block, data += block_size)
+        {
+            block_masks m{};
+            for (size_t i = 0; i < block_size; ++i)
+            {
+                uint8_t  c   = detail::char_classes[static_cast<unsigned char>(data[i])];
+                uint64_t bit = uint64_t{1} << i;
+                m.quote |= (c & detail::quote_class) != 0 ? bit : 0;
+                m.backslash |= (c & detail::backslash_class) != 0 ? bit : 0;
+                m.op |= (c & detail::op_class) != 0 ? bit : 0;
+                m.whitespace |= (c & detail::whitespace_class) != 0 ? bit : 0;
+            }
+            masks[block] = m;
+        }
+    }
+
+#ifdef BOQ_JSON_INDEX_X86
+
+    inline void
+    classify_sse2(const char *data, size_t n_blocks, block_masks *masks)
+    {
+        auto eq   = [](__m128i chunk, char c) { return _mm_cmpeq_epi8(chunk, _mm_set1_epi8(c)); };
+        auto bits = [](__m128i mask) {
+            return static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(mask)));
+        };
+        for (size_t block = 0; block < n_blocks; ++block, data += block_size)
+        {
+            block_masks m{};
+            for (size_t i = 0; i < block_size; i += 16)
+            {
+                __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+                // '[' and ']' differ from '{' and '}' only in the 0x20 bit
+                __m128i lower = _mm_or_si128(chunk, _mm_set1_epi8(0x20));
+                __m128i op    = _mm_or_si128(_mm_or_si128(eq(lower, '{'), eq(lower, '}')),
+                                             _mm_or_si128(eq(chunk, ':'), eq(chunk, ',')));
+                __m128i whitespace = _mm_or_si128(_mm_or_si128(eq(chunk, ' '), eq(chunk, '\t')),
+                                                  _mm_or_si128(eq(chunk, '\n'), eq(chunk, '\r')));
+                m.quote |= bits(eq(chunk, '"')) << i;
+                m.backslash |= bits(eq(chunk, '\\')) << i;
+                m.op |= bits(op) << i;
+                m.whitespace |= bits(whitespace) << i;
+            }
+            masks[block] = m;
+        }
+    }
+
+    namespace detail
+    {
+        // lambdas in a function with a target attribute don't inherit it, so the AVX2 helpers are functions
+
+        __attribute__((target("avx2"))) inline __m256i
+        eq_avx2(__m256i chunk, char c)
+        {
+            return _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(c));
+        }
+
+        __attribute__((target("avx2"))) inline uint64_t
+        bits_avx2(__m256i mask)
+        {
+            return static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(mask)));
+        }
+    } // namespace detail
+
+    __attribute__((target("avx2"))) inline void
+    classify_avx2(const char *data, size_t n_blocks, block_masks *masks)
+    {
+        using detail::bits_avx2;
+        using detail::eq_avx2;
+        for (size_t block = 0; block < n_blocks; ++block, data += block_size)
+        {
+            block_masks m{};
+            for (size_t i = 0; i < block_size; i += 32)
+            {
+                __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+                __m256i lower = _mm256_or_si256(chunk, _mm256_set1_epi8(0x20));
+                __m256i op    = _mm256_or_si256(_mm256_or_si256(eq_avx2(lower, '{'), eq_avx2(lower, '}')),
+                                                _mm256_or_si256(eq_avx2(chunk, ':'), eq_avx2(chunk, ',')));
+                __m256i whitespace = _mm256_or_si256(_mm256_or_si256(eq_avx2(chunk, ' '), eq_avx2(chunk, '\t')),
+                                                     _mm256_or_si256(eq_avx2(chunk, '\n'), eq_avx2(chunk, '\r')));
+                m.quote |= bits_avx2(eq_avx2(chunk, '"')) << i;
+                m.backslash |= bits_avx2(eq_avx2(chunk, '\\')) << i;
+                m.op |= bits_avx2(op) << i;
+                m.whitespace |= bits_avx2(whitespace) << i;
+            }
+            masks[block] = m;
+        }
+    }
+
+    inline classify_fn
+    select_classify()
+    {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return classify_avx2;
+        }
+        return classify_sse2;
+    }
+
+#else
+
+    inline classify_fn
+    select_classify()
+    {
+        return classify_scalar;
+    }
+
+#endif // BOQ_JSON_INDEX_X86
+
+    /// Classifies with the fastest implementation supported by the CPU.
+    inline void
+    classify(const char *data, size_t n_blocks, block_masks *masks)
+    {
+        static const classify_fn impl = select_classify();
+        impl(data, n_blocks, masks);
+    }
+} // namespace json_index
+
+/// The positions of all tokens of a JSON input (stage 1 output), see json_index above. Pass it to a JSONReader together
+/// with the same input to parse by walking the positions. Inputs are limited to 4 GiB, so positions fit in 32 bits.
+class StructuralIndex
+{
+  public:
+    explicit StructuralIndex(std::string_view input, json_index::classify_fn classify = json_index::classify)
+    {
+        build(input, classify);
+    }
+
+    /// Indexes another input, reusing the memory of this index.
+    void
+    build(std::string_view input, json_index::classify_fn classify = json_index::classify)
+    {
+        if (input.size() > std::numeric_limits<uint32_t>::max())
+        {
+            throw std::length_error("StructuralIndex: inputs are limited to 4 GiB");
+        }
+        m_size = 0;
+        // about one token per 8 bytes is typical, the buffer grows if there are more
+        reserve(input.size() / 8 + json_index::block_size);
+        build_positions(input, classify);
+    }
+
+    const uint32_t *
+    begin() const
+    {
+        return m_positions.get();
+    }
+
+    const uint32_t *
+    end() const
+    {
+        return m_positions.get() + m_size;
+    }
+
+    size_t
+    size() const
+    {
+        return m_size;
+    }
+
+  private:
+    std::unique_ptr<uint32_t[]> m_positions;
+    size_t                      m_size     = 0;
+    size_t                      m_capacity = 0;
+
+    /// number of blocks classified at once, the masks of a batch stay in the L1 cache
+    static constexpr size_t batch_blocks = 64;
+
+    void
+    build_positions(std::string_view input, json_index::classify_fn classify)
+    {
+        std::array<json_index::block_masks, batch_blocks> masks;
+        uint64_t prev_escaped   = 0;
+        uint64_t prev_in_string = 0;
+        uint64_t prev_scalar    = 0;
+        auto     process        = [&](size_t n_blocks, size_t block_offset) {
+            for (size_t block = 0; block < n_blocks; ++block)
+            {
+                const json_index::block_masks &m = masks[block];
+
+                uint64_t escaped   = json_index::detail::find_escaped(m.backslash, prev_escaped);
+                uint64_t quote     = m.quote & ~escaped;
+                uint64_t in_string = json_index::detail::prefix_xor(quote) ^ prev_in_string;
+                prev_in_string     = 0 - (in_string >> 63);
+
+                // a scalar starts where a byte outside strings that isn't an operator, quote or whitespace follows
+                // one that is
+                uint64_t scalar       = ~(m.op | m.whitespace | m.quote) & ~in_string;
+                uint64_t scalar_start = scalar & ~(scalar << 1 | prev_scalar);
+                prev_scalar           = scalar >> 63;
+
+                // opening quotes are inside the string according to in_string, closing quotes are not
+                uint64_t tokens = (m.op & ~in_string) | (quote & in_string) | scalar_start;
+                append(tokens, block_offset + block * json_index::block_size);
+            }
+        };
+
+        const char *data         = input.data();
+        size_t      n_full       = input.size() / json_index::block_size;
+        size_t      block_offset = 0;
+        while (n_full > 0)
+        {
+            size_t n_blocks = std::min(n_full, batch_blocks);
+            classify(data + block_offset, n_blocks, masks.data());
+            process(n_blocks, block_offset);
+            n_full -= n_blocks;
+            block_offset += n_blocks * json_index::block_size;
+        }
+        if (size_t rest = input.size() - block_offset; rest > 0)
+        {
+            // the last partial block is padded with whitespace
+            char last_block[json_index::block_size];
+            std::memset(last_block, ' ', json_index::block_size);
+            std::memcpy(last_block, data + block_offset, rest);
+            classify(last_block, 1, masks.data());
+            process(1, block_offset);
+        }
+    }
+
+    void
+    append(uint64_t tokens, size_t block_offset)
+    {
+        if (m_capacity - m_size < json_index::block_size)
+        {
+            reserve(2 * m_capacity);
+        }
+        // the positions are written in groups of 4 without checking for the end of the tokens, which avoids a
+        // mispredicted branch per token; the writes past the last token land in the reserved space and are ignored
+        uint32_t *out      = m_positions.get() + m_size;
+        auto      n_tokens = static_cast<size_t>(__builtin_popcountll(tokens));
+        auto      base     = static_cast<uint32_t>(block_offset);
+        auto      next     = [&tokens, base]() {
+            // the extra bit keeps __builtin_ctzll defined when all tokens have been written
+            auto position = base + static_cast<uint32_t>(__builtin_ctzll(tokens | uint64_t{1} << 63));
+            tokens &= tokens - 1;
+            return position;
+        };
+        for (size_t i = 0; i < n_tokens; i += 4)
+        {
+            out[i]     = next();
+            out[i + 1] = next();
+            out[i + 2] = next();
+            out[i + 3] = next();
+        }
+        m_size += n_tokens;
+    }
+
+    void
+    reserve(size_t capacity)
+    {
+        if (capacity <= m_capacity)
+        {
+            return;
+        }
+        auto new_positions = std::make_unique_for_overwrite<uint32_t[]>(capacity);
+        if (m_size > 0)
+        {
+            std::memcpy(new_positions.get(), m_positions.get(), m_size * sizeof(uint32_t));
+        }
+        m_positions = std::move(new_positions);
+        m_capacity  = capacity;
+    }
+};
+
+#endif // BOQ_JSON_STRUCTURAL_INDEX_H
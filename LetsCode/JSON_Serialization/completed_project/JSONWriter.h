@@ -0,0 +1,337 @@
+#ifndef BOQ_JSON_WRITER_H
+#define BOQ_JSON_WRITER_H
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <concepts>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "FixedString.h"
+#include "JSONEscape.h"
+#include "JSONReflection.h"
+#include "OutputSinks.h"
+
+/// Specifies a name-value pair. Used when streaming to a JSONWriter instance.
+template <typename T>
+struct NVP
+{
+    const std::string &name;
+    const T           &value;
+};
+
+/// Convenience function to create name-value pairs
+template <typename T>
+NVP<T>
+nvp(const std::string &name, const T &value)
+{
+    return NVP<T>{name, value};
+}
+
+/// Deduction guide te ensure the NVP struct can be initialized using the uniform initializer syntax without having to
+/// specify template parameters.
+template <typename T>
+NVP(std::string, T) -> NVP<T>;
+
+namespace json_detail
+{
+    template <typename SINK>
+    constexpr void
+    write_key_fragment(SINK &sink, std::string_view key, bool with_separator)
+    {
+        if (with_separator)
+        {
+            sink.write(", ", 2);
+        }
+        sink.put('"');
+        json_escape::write_escaped(sink, key, json_escape::find_escape_scalar);
+        sink.write("\" : ", 4);
+    }
+
+    /// The escaped and quoted key followed by the colon, preceded by the separator from the previous pair if
+    /// with_separator is set. For example: , "street_name" :
+    template <fixed_string KEY, bool with_separator>
+    struct key_fragment
+    {
+        static constexpr auto data = []() {
+            constexpr size_t size = []() {
+                counting_sink counter;
+                write_key_fragment(counter, KEY.view(), with_separator);
+                return counter.size;
+            }();
+            std::array<char, size> result{};
+            array_sink             sink{result.data()};
+            write_key_fragment(sink, KEY.view(), with_separator);
+            return result;
+        }();
+
+        static constexpr std::string_view value{data.data(), data.size()};
+    };
+} // namespace json_detail
+
+/// Name-value pair with the name known at compile time. The quoted key is prepared at compile time and written with a
+/// single copy, and unlike NVP no std::string is created for the name.
+template <fixed_string KEY, typename T>
+struct StaticNVP
+{
+    const T &value;
+
+    static constexpr std::string_view first_fragment = json_detail::key_fragment<KEY, false>::value;
+    static constexpr std::string_view next_fragment  = json_detail::key_fragment<KEY, true>::value;
+};
+
+/// Convenience function to create name-value pairs with a compile-time name: nvp<"street_name">(a.street_name)
+template <fixed_string KEY, typename T>
+StaticNVP<KEY, T>
+nvp(const T &value)
+{
+    return StaticNVP<KEY, T>{value};
+}
+
+/// Concept which specifies the category of types that should be serialized to a JSON list / array.
+/// We define a list to be a type that support indexing and a .begin() and .end() operator. Furthermore, since string
+/// types often also fit this description, we explicitly exclude any string-like types from the concept.
+template <typename T>
+concept JSONListLike = requires(T t) {
+    t[0];
+    t.begin();
+    t.end();
+    requires !std::is_convertible_v<T, std::string>;
+};
+
+/// The basic_json_writer class can be used to serialize data to json and output it to a sink (see OutputSinks.h).
+/// Data should be passed to instances of the class using the streaming operator and while wrapped in an NVP (name-value
+/// pair) struct.
+/// The JSON object is closed when the writer instance goes out of scope, following the RAII principle.
+///
+/// SINK is either a sink type that is stored in the writer, or a reference to a sink that outlives the writer:
+///   JSONWriter        writer{std::cout};  // basic_json_writer<OStreamSink>, see the JSONWriter alias below
+///   BufferSink        buffer;
+///   basic_json_writer writer{buffer};     // basic_json_writer<BufferSink &>
+template <typename SINK>
+class basic_json_writer
+{
+    // type trait used to check if a type is an nvp. Used for improved error reporting.
+    template <typename T>
+    struct is_nvp : std::false_type
+    {
+    };
+
+    template <typename T>
+    struct is_nvp<NVP<T>> : std::true_type
+    {
+    };
+
+    template <fixed_string KEY, typename T>
+    struct is_nvp<StaticNVP<KEY, T>> : std::true_type
+    {
+    };
+
+    template <typename T>
+    static constexpr bool is_nvp_v = is_nvp<T>::value;
+
+    static_assert(OutputSink<std::remove_reference_t<SINK>>, "basic_json_writer requires a type satisfying OutputSink");
+
+  public:
+    template <typename T>
+        requires std::constructible_from<SINK, T &&>
+    explicit basic_json_writer(T &&sink) : m_sink(std::forward<T>(sink))
+    {
+        write("{ ");
+    }
+    basic_json_writer(const basic_json_writer &)            = delete;
+    basic_json_writer &operator=(const basic_json_writer &) = delete;
+    ~basic_json_writer()
+    {
+        write(" }");
+    }
+
+    template <typename T>
+    basic_json_writer &
+    operator<<(const T &)
+    {
+        static_assert(is_nvp_v<T>, "To serialize to JSON, pass name-value pairs using the NVP struct");
+        return *this;
+    }
+
+    template <typename T>
+    basic_json_writer &
+    operator<<(const NVP<T> &nvp)
+    {
+        if (!m_first_nvp)
+        {
+            write(", ");
+        }
+        // escaped like string values, so a key is written the same as a compile-time key (see StaticNVP)
+        write_quoted(nvp.name);
+        write(" : ");
+        serialize_value(nvp.value);
+        m_first_nvp = false;
+        return *this;
+    }
+
+    template <fixed_string KEY, typename T>
+    basic_json_writer &
+    operator<<(const StaticNVP<KEY, T> &nvp)
+    {
+        using nvp_t = StaticNVP<KEY, T>;
+        write(m_first_nvp ? nvp_t::first_fragment : nvp_t::next_fragment);
+        serialize_value(nvp.value);
+        m_first_nvp = false;
+        return *this;
+    }
+
+  private:
+    SINK m_sink;
+    bool m_first_nvp = true;
+
+    void
+    write(std::string_view s)
+    {
+        m_sink.write(s.data(), s.size());
+    }
+
+    template <typename T>
+    void
+    serialize_value(const T &)
+    {
+        static_assert(!std::is_same_v<T, T>, "Type can't be serialized to JSON");
+    }
+
+    void
+    serialize_value(bool b)
+    {
+        write(b ? "true" : "false");
+    }
+
+    template <typename T>
+        requires(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>)
+    void
+    serialize_value(const T &t)
+    {
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            if (!std::isfinite(t))
+            {
+                // JSON has no representation for NaN and infinity, JSON.stringify writes null as well
+                write("null");
+                return;
+            }
+        }
+        write_number(t);
+    }
+
+    /// Writes the number with std::to_chars: locale independent, and floating point numbers are written with the
+    /// shortest representation that parses back to exactly the same value.
+    template <typename T>
+    void
+    write_number(T t)
+    {
+        // enough for any integer and the shortest representation of any floating point type up to long double
+        constexpr size_t max_size = 64;
+        if constexpr (requires { m_sink.allocate(max_size); })
+        {
+            // format directly into the sink
+            char *first  = m_sink.allocate(max_size);
+            char *last   = std::to_chars(first, first + max_size, t).ptr;
+            m_sink.shrink_by(max_size - static_cast<size_t>(last - first));
+        }
+        else
+        {
+            char  buffer[max_size];
+            char *last = std::to_chars(std::begin(buffer), std::end(buffer), t).ptr;
+            m_sink.write(buffer, static_cast<size_t>(last - buffer));
+        }
+    }
+
+    template <typename T>
+        requires(std::is_convertible_v<T, std::string>)
+    void
+    serialize_value(const T &t)
+    {
+        if constexpr (std::is_convertible_v<const T &, std::string_view>)
+        {
+            write_quoted(t);
+        }
+        else
+        {
+            write_quoted(std::string(t));
+        }
+    }
+
+    /// Writes the string between quotes, escaping the characters that are not allowed in JSON strings.
+    void
+    write_quoted(std::string_view s)
+    {
+        m_sink.put('"');
+        json_escape::write_escaped(m_sink, s);
+        m_sink.put('"');
+    }
+
+    template <JSONListLike L>
+    void
+    serialize_value(const L &list)
+    {
+        bool is_first = true;
+        write("[ ");
+        for (const auto &e : list)
+        {
+            if (!is_first)
+            {
+                write(", ");
+            }
+            serialize_value(e);
+            is_first = false;
+        }
+        write(" ]");
+    }
+
+    template <typename T>
+        requires(std::is_class_v<T> && !std::is_convertible_v<T, std::string> && !JSONListLike<T> &&
+                 !JSONReflected<T>)
+    void
+    serialize_value(const T &t)
+    {
+        static_assert(
+            requires(basic_json_writer &writer) { serialize(writer, t); },
+            "Serialization of custom classes requires a serialize overload to be defined");
+        m_first_nvp = true;
+        write("{ ");
+        serialize(*this, t);
+        write(" }");
+    }
+
+    /// Serializer generated from the json_fields of T (see JSONReflection.h): the merged constant fragments and the
+    /// leaf values are written alternately, without any runtime bookkeeping of separators.
+    template <JSONReflected T>
+    void
+    serialize_value(const T &t)
+    {
+        using plan = json_detail::serializer_plan<T>;
+        [this, &t]<size_t... leaf_indices>(std::index_sequence<leaf_indices...>) {
+            ((write(plan::fragment(leaf_indices)),
+              serialize_value(std::tuple_element_t<leaf_indices, typename plan::leaves>::get(t))),
+             ...);
+        }(std::make_index_sequence<plan::n_leaves>{});
+        write(plan::fragment(plan::n_leaves));
+    }
+};
+
+template <typename STREAM>
+    requires std::is_base_of_v<std::ostream, STREAM>
+basic_json_writer(STREAM &) -> basic_json_writer<OStreamSink>;
+
+template <OutputSink SINK>
+    requires(!std::is_base_of_v<std::ostream, SINK>)
+basic_json_writer(SINK &) -> basic_json_writer<SINK &>;
+
+/// The writer to a std::ostream. Serializers written for it, e.g. void serialize(JSONWriter &, const T &), work as
+/// before; serializers that should work with any sink take a basic_json_writer<SINK> & instead.
+using JSONWriter = basic_json_writer<OStreamSink>;
+
+#endif // BOQ_JSON_WRITER_H
@@ -0,0 +1,103 @@
+#ifndef BOQ_MAPPED_FILE_H
+#define BOQ_MAPPED_FILE_H
+
+#if __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define BOQ_HAS_MAPPED_FILE
+#endif
+
+#ifdef BOQ_HAS_MAPPED_FILE
+
+#include <cerrno>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+/// Read-only memory mapping of a whole file, so a JSONReader can parse it without copying it into a buffer first.
+/// The constructor throws std::system_error if the file can't be opened or mapped.
+class MappedFile
+{
+  public:
+    explicit MappedFile(const std::string &path)
+    {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            throw std::system_error(errno, std::generic_category(), "MappedFile: can't open " + path);
+        }
+        struct stat status
+        {
+        };
+        if (::fstat(fd, &status) != 0)
+        {
+            int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), "MappedFile: can't stat " + path);
+        }
+        m_size = static_cast<size_t>(status.st_size);
+        if (m_size > 0)
+        {
+            void *data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED)
+            {
+                int error = errno;
+                ::close(fd);
+                throw std::system_error(error, std::generic_category(), "MappedFile: can't map " + path);
+            }
+            m_data = static_cast<const char *>(data);
+            // the input is read front to back
+            ::madvise(data, m_size, MADV_SEQUENTIAL);
+        }
+        // the mapping stays valid after closing the file descriptor
+        ::close(fd);
+    }
+    MappedFile(MappedFile &&other) noexcept
+        : m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0))
+    {
+    }
+    MappedFile &
+    operator=(MappedFile &&other) noexcept
+    {
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+        return *this;
+    }
+    ~MappedFile()
+    {
+        if (m_data != nullptr)
+        {
+            ::munmap(const_cast<char *>(m_data), m_size);
+        }
+    }
+
+    const char *
+    data() const
+    {
+        return m_data;
+    }
+
+    size_t
+    size() const
+    {
+        return m_size;
+    }
+
+    std::string_view
+    view() const
+    {
+        return {m_data, m_size};
+    }
+
+  private:
+    const char *m_data = nullptr;
+    size_t      m_size = 0;
+};
+
+#endif // BOQ_HAS_MAPPED_FILE
+
+#endif // BOQ_MAPPED_FILE_H
@@ -0,0 +1,284 @@
+#ifndef BOQ_OUTPUT_SINKS_H
+#define BOQ_OUTPUT_SINKS_H
+
+#include <algorithm>
+#include <cerrno>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <string_view>
+#include <system_error>
+
+#if __has_include(<unistd.h>)
+#include <unistd.h>
+#define BOQ_HAS_FD_SINK
+#endif
+
+// Output sinks receive the bytes produced by the JSONWriter. A sink only has to provide an unformatted write of a
+// range of bytes and of a single character, so the writer never goes through the formatting machinery (sentries,
+// locales, stream flags) of std::ostream.
+
+/// Concept for the types a JSONWriter can write to.
+template <typename T>
+concept OutputSink = requires(T sink, const char *data, size_t size, char c) {
+    sink.write(data, size);
+    sink.put(c);
+};
+
+/// Sink appending to a std::ostream, for compatibility with code that serializes to streams.
+/// Uses the unformatted ostream::write, the stream's formatting flags and locale have no effect on the output.
+class OStreamSink
+{
+  public:
+    explicit OStreamSink(std::ostream &stream) : m_stream(stream)
+    {
+    }
+
+    void
+    write(const char *data, size_t size)
+    {
+        m_stream.write(data, static_cast<std::streamsize>(size));
+    }
+
+    void
+    put(char c)
+    {
+        m_stream.put(c);
+    }
+
+  private:
+    std::ostream &m_stream;
+};
+
+/// Sink collecting the output in a growable contiguous buffer. Unlike std::string or std::vector, growing the buffer
+/// doesn't initialize the new bytes.
+class BufferSink
+{
+  public:
+    BufferSink() = default;
+    explicit BufferSink(size_t initial_capacity)
+    {
+        reserve(std::max<size_t>(initial_capacity, 1));
+    }
+
+    void
+    write(const char *data, size_t size)
+    {
+        if (size == 0)
+        {
+            // the buffer of an empty sink may not be allocated yet, and memcpy doesn't accept a null pointer
+            return;
+        }
+        std::memcpy(allocate(size), data, size);
+    }
+
+    void
+    put(char c)
+    {
+        *allocate(1) = c;
+    }
+
+    /// Returns a pointer to size bytes at the end of the buffer, which the caller has to fill.
+    char *
+    allocate(size_t size)
+    {
+        if (m_capacity - m_size < size)
+        {
+            reserve(std::max(2 * m_capacity, m_size + size));
+        }
+        char *result = m_data.get() + m_size;
+        m_size += size;
+        return result;
+    }
+
+    /// Removes the last n bytes, e.g. those that weren't used after a call to allocate.
+    void
+    shrink_by(size_t n)
+    {
+        m_size -= n;
+    }
+
+    void
+    reserve(size_t capacity)
+    {
+        if (capacity <= m_capacity)
+        {
+            return;
+        }
+        auto new_data = std::make_unique_for_overwrite<char[]>(capacity);
+        if (m_size > 0)
+        {
+            std::memcpy(new_data.get(), m_data.get(), m_size);
+        }
+        m_data     = std::move(new_data);
+        m_capacity = capacity;
+    }
+
+    void
+    clear()
+    {
+        m_size = 0;
+    }
+
+    const char *
+    data() const
+    {
+        return m_data.get();
+    }
+
+    size_t
+    size() const
+    {
+        return m_size;
+    }
+
+    std::string_view
+    view() const
+    {
+        return {m_data.get(), m_size};
+    }
+
+  private:
+    std::unique_ptr<char[]> m_data;
+    size_t                  m_size     = 0;
+    size_t                  m_capacity = 0;
+};
+
+namespace json_detail
+{
+    /// Sink that only counts the bytes written to it, used to size the text generated at compile time.
+    struct counting_sink
+    {
+        size_t size = 0;
+
+        constexpr void
+        write(const char *, size_t n)
+        {
+            size += n;
+        }
+        constexpr void
+        put(char)
+        {
+            ++size;
+        }
+    };
+
+    /// Sink writing to a char array at compile time.
+    struct array_sink
+    {
+        char *out;
+
+        constexpr void
+        write(const char *data, size_t n)
+        {
+            out = std::copy_n(data, n, out);
+        }
+        constexpr void
+        put(char c)
+        {
+            *out++ = c;
+        }
+    };
+} // namespace json_detail
+
+#ifdef BOQ_HAS_FD_SINK
+
+/// Sink writing to a file descriptor (file, pipe, socket, ...) through a fixed size buffer, so the output is written
+/// with few system calls. The sink doesn't own the file descriptor.
+/// flush() throws std::system_error if the output can't be written. The destructor flushes as well, but has to ignore
+/// errors, call flush() explicitly to detect them.
+class FdSink
+{
+  public:
+    static constexpr size_t default_buffer_size = 64 * 1024;
+
+    /// buffer_size is at least 1, put() needs room for a character after flushing.
+    explicit FdSink(int fd, size_t buffer_size = default_buffer_size)
+        : m_fd(fd), m_capacity(std::max<size_t>(buffer_size, 1))
+    {
+        m_buffer = std::make_unique_for_overwrite<char[]>(m_capacity);
+    }
+    FdSink(const FdSink &) = delete;
+    FdSink &operator=(const FdSink &) = delete;
+    ~FdSink()
+    {
+        write_all(m_buffer.get(), m_size);
+    }
+
+    void
+    write(const char *data, size_t size)
+    {
+        if (m_capacity - m_size < size)
+        {
+            flush();
+            if (size >= m_capacity)
+            {
+                // too large to be buffered, write it directly
+                write_or_throw(data, size);
+                return;
+            }
+        }
+        std::memcpy(m_buffer.get() + m_size, data, size);
+        m_size += size;
+    }
+
+    void
+    put(char c)
+    {
+        if (m_size == m_capacity)
+        {
+            flush();
+        }
+        m_buffer[m_size++] = c;
+    }
+
+    void
+    flush()
+    {
+        size_t size = m_size;
+        m_size      = 0;
+        write_or_throw(m_buffer.get(), size);
+    }
+
+  private:
+    int                     m_fd;
+    std::unique_ptr<char[]> m_buffer;
+    size_t                  m_size = 0;
+    size_t                  m_capacity;
+
+    /// Writes all bytes, retrying partial writes and interrupted calls. Returns errno on failure, 0 on success.
+    int
+    write_all(const char *data, size_t size) const
+    {
+        while (size > 0)
+        {
+            ssize_t n_written = ::write(m_fd, data, size);
+            if (n_written < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                return errno;
+            }
+            data += n_written;
+            size -= static_cast<size_t>(n_written);
+        }
+        return 0;
+    }
+
+    void
+    write_or_throw(const char *data, size_t size) const
+    {
+        if (int error = write_all(data, size); error != 0)
+        {
+            throw std::system_error(error, std::generic_category(), "FdSink: write failed");
+        }
+    }
+};
+
+#endif // BOQ_HAS_FD_SINK
+
+#endif // BOQ_OUTPUT_SINKS_H
@@ -0,0 +1,40 @@
+#ifndef BOQ_TEST_TYPES_H
+#define BOQ_TEST_TYPES_H
+
+#include <string>
+
+#include "JSONWriter.h"
+
+/// Used for testing custom type serialization
+struct Address
+{
+    std::string street_name;
+    int         house_number;
+};
+
+/// Used for testing custom type serialization
+struct Person
+{
+    std::string name;
+    Address     address;
+};
+
+/// Serialization definition for custom classes used in the tests ///
+
+template <typename SINK>
+void
+serialize(basic_json_writer<SINK> &writer, const Address &a)
+{
+    writer << NVP{"street_name", a.street_name};
+    writer << NVP{"house_number", a.house_number};
+}
+
+template <typename SINK>
+void
+serialize(basic_json_writer<SINK> &writer, const Person &p)
+{
+    writer << NVP{"name", p.name};
+    writer << NVP{"address", p.address};
+}
+
+#endif // BOQ_TEST_TYPES_H
@@ -0,0 +1,55 @@
+#ifndef BOQ_THROUGHPUT_H
+#define BOQ_THROUGHPUT_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <string_view>
+
+/// Minimal throughput measurement for the JSON benchmarks. For serious measurements, use a well-established library
+/// such as Google Benchmark.
+namespace throughput
+{
+    /// Prevents the compiler from optimizing away the computation of value.
+    template <typename T>
+    inline void
+    do_not_optimize(T &&value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static_cast<void>(value);
+#endif
+    }
+
+    inline void
+    print_header()
+    {
+        std::printf("%-48s %12s %12s\n", "benchmark", "ms/iter", "MB/s");
+    }
+
+    /// Runs the function n_iterations times (after one warmup run) and prints the time per iteration and the
+    /// throughput. The function returns the number of bytes it processed.
+    template <typename FUNC>
+    double
+    run(std::string_view name, size_t n_iterations, FUNC &&function)
+    {
+        do_not_optimize(function());
+
+        size_t n_bytes = 0;
+        auto   start   = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < n_iterations; ++i)
+        {
+            n_bytes += function();
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        double seconds          = std::chrono::duration<double>(end - start).count();
+        double mega_bytes_per_s = static_cast<double>(n_bytes) / seconds / 1e6;
+        std::printf("%-48.*s %12.3f %12.1f\n", static_cast<int>(name.size()), name.data(),
+                    seconds * 1e3 / static_cast<double>(n_iterations), mega_bytes_per_s);
+        return mega_bytes_per_s;
+    }
+} // namespace throughput
+
+#endif // BOQ_THROUGHPUT_H
@@ -0,0 +1,114 @@
+// Benchmarks deserialization of reflected types with keys dispatched through the compile-time perfect hash table,
+// against matching each key linearly with the field names, for structs with 4, 16 and 64 fields.
+
+#include <array>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "../JSONDeserialize.h"
+#include "../JSONReader.h"
+#include "../JSONReflection.h"
+#include "../JSONWriter.h"
+#include "../OutputSinks.h"
+#include "Throughput.h"
+
+namespace
+{
+    constexpr size_t n_iterations = 10;
+    constexpr size_t n_values     = 2'000'000; // number of fields in each document, spread over the objects
+
+    /// Provides the member of field i of a wide struct.
+    template <size_t i>
+    struct member
+    {
+        int value;
+    };
+
+    /// Struct with one int member per index, the fields are named field_0, field_1, ...
+    template <size_t... indices>
+    struct Wide : member<indices>...
+    {
+    };
+
+    template <size_t... indices>
+    Wide<indices...> make_wide(std::index_sequence<indices...>);
+
+    template <size_t n_fields>
+    using wide_t = decltype(make_wide(std::make_index_sequence<n_fields>{}));
+
+    template <size_t i>
+    constexpr auto field_name = []() {
+        fixed_string<9> name{"field_00"};
+        name.data[6] = static_cast<char>('0' + i / 10);
+        name.data[7] = static_cast<char>('0' + i % 10);
+        return name;
+    }();
+} // namespace
+
+template <size_t... indices>
+struct json_fields<Wide<indices...>>
+{
+    static constexpr std::tuple value{field<field_name<indices>, &member<indices>::value>{}...};
+};
+
+namespace
+{
+    template <typename LOOKUP, typename T>
+    void
+    deserialize_list(JSONReader &reader, std::vector<T> &list)
+    {
+        json_detail::expect(reader, JSONEvent::begin_array, "expected an array");
+        list.clear();
+        while (reader.peek() != JSONEvent::end_array)
+        {
+            json_detail::deserialize_object<LOOKUP>(reader, list.emplace_back());
+        }
+        reader.next();
+    }
+
+    template <size_t n_fields>
+    void
+    benchmark_deserialize()
+    {
+        using T = wide_t<n_fields>;
+        std::vector<T> objects(n_values / n_fields);
+        int            counter = 0;
+        for (T &object : objects)
+        {
+            [&]<size_t... indices>(std::index_sequence<indices...>) {
+                ((static_cast<member<indices> &>(object).value = counter++), ...);
+            }(std::make_index_sequence<n_fields>{});
+        }
+        BufferSink sink;
+        {
+            basic_json_writer writer{sink};
+            writer << nvp<"objects">(objects);
+        }
+
+        auto run = [&]<typename LOOKUP>(const std::string &name) {
+            std::vector<T> result;
+            throughput::run(std::to_string(n_fields) + " fields, " + name, n_iterations, [&]() {
+                JSONReader reader{sink.view()};
+                reader.next();
+                reader.next();
+                deserialize_list<LOOKUP>(reader, result);
+                throughput::do_not_optimize(result.data());
+                return sink.size();
+            });
+        };
+        run.template operator()<json_detail::linear_lookup<T>>("linear key matching");
+        run.template operator()<json_detail::perfect_hash_lookup<T>>("perfect hash");
+    }
+} // namespace
+
+int
+main()
+{
+    throughput::print_header();
+    benchmark_deserialize<4>();
+    benchmark_deserialize<16>();
+    benchmark_deserialize<64>();
+    return 0;
+}
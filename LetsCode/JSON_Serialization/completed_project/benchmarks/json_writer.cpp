@@ -0,0 +1,130 @@
+// Benchmarks serializing a vector of Person/Address objects with JSONWriter to the different output sinks, against a
+// copy of the former writer that formatted every token through std::ostream operator<< (with std::boolalpha and
+// std::quoted).
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../JSONWriter.h"
+#include "../OutputSinks.h"
+#include "../TestTypes.h"
+#include "Throughput.h"
+
+namespace
+{
+    constexpr size_t n_people     = 100'000;
+    constexpr size_t n_iterations = 10;
+
+    std::vector<Person>
+    make_people()
+    {
+        std::vector<Person> people;
+        people.reserve(n_people);
+        for (size_t i = 0; i < n_people; ++i)
+        {
+            people.push_back(Person{"person_" + std::to_string(i),
+                                    Address{"street number " + std::to_string(i % 997), static_cast<int>(i % 300)}});
+        }
+        return people;
+    }
+
+    // the output of the former writer, token by token
+    void
+    legacy_serialize(std::ostream &stream, const std::vector<Person> &people)
+    {
+        stream << "{ " << std::boolalpha << "\"" << "people" << "\" : [ ";
+        bool is_first = true;
+        for (const auto &p : people)
+        {
+            if (!is_first)
+            {
+                stream << ", ";
+            }
+            stream << "{ " << std::boolalpha << "\"" << "name" << "\" : " << std::quoted(p.name);
+            stream << ", " << std::boolalpha << "\"" << "address" << "\" : { ";
+            stream << std::boolalpha << "\"" << "street_name" << "\" : " << std::quoted(p.address.street_name);
+            stream << ", " << std::boolalpha << "\"" << "house_number" << "\" : " << p.address.house_number;
+            stream << " } }";
+            is_first = false;
+        }
+        stream << " ] }";
+    }
+} // namespace
+
+int
+main()
+{
+    const auto people = make_people();
+
+    // /dev/null doesn't report the number of bytes written, so the output size is measured once up front
+    BufferSink reused_sink;
+    {
+        basic_json_writer writer{reused_sink};
+        writer << NVP{"people", people};
+    }
+    const size_t n_bytes = reused_sink.size();
+
+    throughput::print_header();
+
+    throughput::run("legacy ostream formatting (stringstream)", n_iterations, [&]() {
+        std::ostringstream ss;
+        legacy_serialize(ss, people);
+        return ss.str().size();
+    });
+    throughput::run("OStreamSink (stringstream)", n_iterations, [&]() {
+        std::ostringstream ss;
+        {
+            JSONWriter writer{ss};
+            writer << NVP{"people", people};
+        }
+        return ss.str().size();
+    });
+    throughput::run("BufferSink", n_iterations, [&]() {
+        BufferSink sink;
+        {
+            basic_json_writer writer{sink};
+            writer << NVP{"people", people};
+        }
+        return sink.size();
+    });
+    throughput::run("BufferSink (reused)", n_iterations, [&]() {
+        reused_sink.clear();
+        {
+            basic_json_writer writer{reused_sink};
+            writer << NVP{"people", people};
+        }
+        return reused_sink.size();
+    });
+
+    std::ofstream dev_null_stream{"/dev/null"};
+    throughput::run("legacy ostream formatting (/dev/null)", n_iterations, [&]() {
+        legacy_serialize(dev_null_stream, people);
+        return n_bytes;
+    });
+    throughput::run("OStreamSink (/dev/null)", n_iterations, [&]() {
+        {
+            JSONWriter writer{dev_null_stream};
+            writer << NVP{"people", people};
+        }
+        return n_bytes;
+    });
+
+    int dev_null = ::open("/dev/null", O_WRONLY);
+    throughput::run("FdSink (/dev/null)", n_iterations, [&]() {
+        FdSink sink{dev_null};
+        {
+            basic_json_writer writer{sink};
+            writer << NVP{"people", people};
+        }
+        sink.flush();
+        return n_bytes;
+    });
+    ::close(dev_null);
+    return 0;
+}
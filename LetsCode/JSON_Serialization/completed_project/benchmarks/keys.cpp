@@ -0,0 +1,116 @@
+// Benchmarks runtime keys (NVP, which creates a std::string per key) against compile-time keys (nvp<"key">, written
+// with a single copy of the prepared fragment) when serializing Person/Address objects, and a log entry whose keys are
+// too long for the small string optimization, so every runtime key allocates.
+
+#include <string>
+#include <vector>
+
+#include "../JSONWriter.h"
+#include "../OutputSinks.h"
+#include "../TestTypes.h"
+#include "Throughput.h"
+
+namespace
+{
+    constexpr size_t n_objects    = 100'000;
+    constexpr size_t n_iterations = 10;
+
+    // the same as Person/Address, serialized with compile-time keys
+    struct StaticAddress
+    {
+        std::string street_name;
+        int         house_number;
+    };
+
+    struct StaticPerson
+    {
+        std::string   name;
+        StaticAddress address;
+    };
+
+    template <typename SINK>
+    void
+    serialize(basic_json_writer<SINK> &writer, const StaticAddress &a)
+    {
+        writer << nvp<"street_name">(a.street_name) << nvp<"house_number">(a.house_number);
+    }
+
+    template <typename SINK>
+    void
+    serialize(basic_json_writer<SINK> &writer, const StaticPerson &p)
+    {
+        writer << nvp<"name">(p.name) << nvp<"address">(p.address);
+    }
+
+    template <bool static_keys>
+    struct LogEntry
+    {
+        int64_t timestamp_microseconds;
+        int     request_duration_microseconds;
+        int     response_status_code;
+        int     response_size_in_bytes;
+    };
+
+    template <typename SINK>
+    void
+    serialize(basic_json_writer<SINK> &writer, const LogEntry<false> &e)
+    {
+        writer << NVP{"timestamp_microseconds", e.timestamp_microseconds};
+        writer << NVP{"request_duration_microseconds", e.request_duration_microseconds};
+        writer << NVP{"response_status_code", e.response_status_code};
+        writer << NVP{"response_size_in_bytes", e.response_size_in_bytes};
+    }
+
+    template <typename SINK>
+    void
+    serialize(basic_json_writer<SINK> &writer, const LogEntry<true> &e)
+    {
+        writer << nvp<"timestamp_microseconds">(e.timestamp_microseconds);
+        writer << nvp<"request_duration_microseconds">(e.request_duration_microseconds);
+        writer << nvp<"response_status_code">(e.response_status_code);
+        writer << nvp<"response_size_in_bytes">(e.response_size_in_bytes);
+    }
+
+    template <typename T>
+    void
+    benchmark_serialize(const std::string &name, const std::vector<T> &objects)
+    {
+        BufferSink sink;
+        throughput::run(name, n_iterations, [&]() {
+            sink.clear();
+            {
+                basic_json_writer writer{sink};
+                writer << nvp<"objects">(objects);
+            }
+            return sink.size();
+        });
+    }
+} // namespace
+
+int
+main()
+{
+    std::vector<Person>          people;
+    std::vector<StaticPerson>    static_people;
+    std::vector<LogEntry<false>> entries;
+    std::vector<LogEntry<true>>  static_entries;
+    for (size_t i = 0; i < n_objects; ++i)
+    {
+        std::string name   = "person " + std::to_string(i);
+        std::string street = "street " + std::to_string(i % 997);
+        int         number = static_cast<int>(i % 300);
+        people.push_back(Person{name, Address{street, number}});
+        static_people.push_back(StaticPerson{name, StaticAddress{street, number}});
+
+        auto t = static_cast<int64_t>(i) * 1000;
+        entries.push_back(LogEntry<false>{t, number, 200, number * 10});
+        static_entries.push_back(LogEntry<true>{t, number, 200, number * 10});
+    }
+
+    throughput::print_header();
+    benchmark_serialize("Person, runtime keys (NVP)", people);
+    benchmark_serialize("Person, compile-time keys (nvp<>)", static_people);
+    benchmark_serialize("log entry, runtime keys (NVP)", entries);
+    benchmark_serialize("log entry, compile-time keys (nvp<>)", static_entries);
+    return 0;
+}
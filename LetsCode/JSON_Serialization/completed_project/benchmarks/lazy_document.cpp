@@ -0,0 +1,147 @@
+// Benchmarks extracting 2 of the 50 fields of each object in an array, with the lazy document against reading the
+// whole document with the JSONReader. The lazy document only builds the structural index and skips the other fields
+// by brace matching, the reader has to parse every value.
+
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../JSONDocument.h"
+#include "../JSONReader.h"
+#include "../JSONWriter.h"
+#include "../OutputSinks.h"
+#include "Throughput.h"
+
+namespace
+{
+    constexpr size_t n_iterations = 10;
+    constexpr size_t n_records    = 100'000;
+    constexpr size_t n_other      = 48; // fields besides id and score
+
+    struct Record
+    {
+        int    id;
+        double score;
+    };
+
+    /// The record's id, 48 other fields (strings, numbers and small arrays) and its score
+    template <typename SINK>
+    void
+    serialize(basic_json_writer<SINK> &writer, const Record &record)
+    {
+        writer << NVP{"id", record.id};
+        for (size_t i = 0; i < n_other; ++i)
+        {
+            std::string name = "field_" + std::to_string(i);
+            switch (i % 3)
+            {
+            case 0:
+                writer << NVP{name, "value " + std::to_string(record.id + static_cast<int>(i))};
+                break;
+            case 1:
+                writer << NVP{name, record.id * static_cast<int>(i)};
+                break;
+            default:
+                writer << NVP{name, std::vector<int>{record.id, static_cast<int>(i), 3}};
+                break;
+            }
+        }
+        writer << NVP{"score", record.score};
+    }
+
+    double
+    to_double(std::string_view text)
+    {
+        double value = 0;
+        std::from_chars(text.data(), text.data() + text.size(), value);
+        return value;
+    }
+} // namespace
+
+int
+main()
+{
+    std::vector<Record> records(n_records);
+    for (size_t i = 0; i < n_records; ++i)
+    {
+        records[i] = Record{static_cast<int>(i), static_cast<double>(i) * 0.25};
+    }
+    BufferSink sink;
+    {
+        basic_json_writer writer{sink};
+        writer << NVP{"records", records};
+    }
+    std::string_view json = sink.view();
+
+    std::vector<Record> result(n_records);
+    throughput::print_header();
+    throughput::run("JSONReader, all fields", n_iterations, [&]() {
+        JSONReader reader{json};
+        size_t     depth = 0;
+        size_t     i     = 0;
+        for (JSONEvent event = reader.next(); event != JSONEvent::end_of_input; event = reader.next())
+        {
+            if (event == JSONEvent::begin_object || event == JSONEvent::begin_array)
+            {
+                ++depth;
+            }
+            else if (event == JSONEvent::end_object || event == JSONEvent::end_array)
+            {
+                i += depth == 3 ? 1 : 0;
+                --depth;
+            }
+            else if (event == JSONEvent::key && depth == 3)
+            {
+                std::string_view key = reader.string_value();
+                if (key == "id")
+                {
+                    reader.next();
+                    result[i].id = static_cast<int>(to_double(reader.string_value()));
+                }
+                else if (key == "score")
+                {
+                    reader.next();
+                    result[i].score = to_double(reader.string_value());
+                }
+            }
+        }
+        throughput::do_not_optimize(result.data());
+        return json.size();
+    });
+    throughput::run("LazyDocument, 2 fields", n_iterations, [&]() {
+        LazyDocument doc{json};
+        LazyArray    array = doc.root()["records"].as_array();
+        for (size_t i = 0; i < array.size(); ++i)
+        {
+            LazyValue record = array[i];
+            result[i]        = Record{record["id"].get<int>(), record["score"].get<double>()};
+        }
+        throughput::do_not_optimize(result.data());
+        return json.size();
+    });
+    LazyDocument reused{json};
+    throughput::run("LazyDocument, 2 fields, reusing the document", n_iterations, [&]() {
+        reused.load(json);
+        LazyArray array = reused.root()["records"].as_array();
+        for (size_t i = 0; i < array.size(); ++i)
+        {
+            LazyValue record = array[i];
+            result[i]        = Record{record["id"].get<int>(), record["score"].get<double>()};
+        }
+        throughput::do_not_optimize(result.data());
+        return json.size();
+    });
+    throughput::run("LazyDocument, 2 fields via as_object", n_iterations, [&]() {
+        LazyDocument doc{json};
+        LazyArray    array = doc.root()["records"].as_array();
+        for (size_t i = 0; i < array.size(); ++i)
+        {
+            LazyObject record = array[i].as_object();
+            result[i]         = Record{record["id"].get<int>(), record["score"].get<double>()};
+        }
+        throughput::do_not_optimize(result.data());
+        return json.size();
+    });
+    return 0;
+}
@@ -0,0 +1,108 @@
+// Benchmarks converting the numbers of arrays of 1M ints, int64s and doubles written by the JSONWriter, with
+// json_number::parse (SWAR digit chunks, exact fast path for doubles) against std::from_chars and
+// strtol/strtoll/strtod, and reading the whole arrays with deserialize.
+
+#include <charconv>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../JSONDeserialize.h"
+#include "../JSONNumber.h"
+#include "../JSONReader.h"
+#include "../JSONWriter.h"
+#include "../OutputSinks.h"
+#include "Throughput.h"
+
+namespace
+{
+    constexpr size_t n_numbers    = 1'000'000;
+    constexpr size_t n_iterations = 10;
+
+    template <typename T>
+    void
+    benchmark_numbers(const std::string &type_name, const std::vector<T> &values, auto &&strto)
+    {
+        BufferSink sink;
+        {
+            basic_json_writer writer{sink};
+            writer << NVP{"values", values};
+        }
+
+        // the texts of the numbers, to measure only the conversion
+        std::vector<std::string_view> texts;
+        size_t                        n_bytes = 0;
+        JSONReader                    reader{sink.view()};
+        for (JSONEvent event = reader.next(); event != JSONEvent::end_of_input; event = reader.next())
+        {
+            if (event == JSONEvent::number)
+            {
+                texts.push_back(reader.string_value());
+                n_bytes += texts.back().size();
+            }
+        }
+
+        std::vector<T> result(texts.size());
+        throughput::run(type_name + ", strto*", n_iterations, [&]() {
+            for (size_t i = 0; i < texts.size(); ++i)
+            {
+                // the numbers are followed by ',' or ' ', which ends the conversion
+                result[i] = strto(texts[i].data());
+            }
+            throughput::do_not_optimize(result.data());
+            return n_bytes;
+        });
+        throughput::run(type_name + ", std::from_chars", n_iterations, [&]() {
+            for (size_t i = 0; i < texts.size(); ++i)
+            {
+                std::from_chars(texts[i].data(), texts[i].data() + texts[i].size(), result[i]);
+            }
+            throughput::do_not_optimize(result.data());
+            return n_bytes;
+        });
+        throughput::run(type_name + ", json_number::parse", n_iterations, [&]() {
+            for (size_t i = 0; i < texts.size(); ++i)
+            {
+                json_number::parse(texts[i], result[i]);
+            }
+            throughput::do_not_optimize(result.data());
+            return n_bytes;
+        });
+        throughput::run(type_name + ", deserialize whole array", n_iterations, [&]() {
+            JSONReader array_reader{sink.view()};
+            array_reader.next();
+            array_reader.next();
+            deserialize(array_reader, result);
+            throughput::do_not_optimize(result.data());
+            return sink.size();
+        });
+    }
+} // namespace
+
+int
+main()
+{
+    std::mt19937_64      rng{42};
+    std::vector<int>     ints(n_numbers);
+    std::vector<int64_t> int64s(n_numbers);
+    std::vector<double>  doubles(n_numbers);
+    std::vector<double>  prices(n_numbers);
+    for (size_t i = 0; i < n_numbers; ++i)
+    {
+        ints[i]    = static_cast<int>(rng());
+        int64s[i]  = static_cast<int64_t>(rng() >> (rng() % 64));
+        doubles[i] = std::uniform_real_distribution<double>{-1e6, 1e6}(rng);
+        prices[i]  = static_cast<double>(rng() % 10'000'000) / 100.0;
+    }
+
+    throughput::print_header();
+    benchmark_numbers("int", ints,
+                      [](const char *text) { return static_cast<int>(std::strtol(text, nullptr, 10)); });
+    benchmark_numbers("int64_t", int64s,
+                      [](const char *text) { return static_cast<int64_t>(std::strtoll(text, nullptr, 10)); });
+    benchmark_numbers("double", doubles, [](const char *text) { return std::strtod(text, nullptr); });
+    benchmark_numbers("double, 2 decimals", prices, [](const char *text) { return std::strtod(text, nullptr); });
+    return 0;
+}
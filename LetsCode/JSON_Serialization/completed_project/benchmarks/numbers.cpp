@@ -0,0 +1,100 @@
+// Benchmarks serializing arrays of 1M doubles and 1M ints with JSONWriter (std::to_chars, shortest round-trip output
+// for doubles) against formatting with std::ostream (the former writer, which rounds doubles to 6 digits, and with
+// precision 17 to round-trip) and with snprintf("%.17g").
+
+#include <cstdio>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../JSONWriter.h"
+#include "../OutputSinks.h"
+#include "Throughput.h"
+
+namespace
+{
+    constexpr size_t n_numbers    = 1'000'000;
+    constexpr size_t n_iterations = 5;
+
+    template <typename T>
+    size_t
+    serialize_with_ostream(const std::vector<T> &values, int precision)
+    {
+        std::ostringstream ss;
+        ss << std::setprecision(precision) << "{ \"values\" : [ ";
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            if (i > 0)
+            {
+                ss << ", ";
+            }
+            ss << values[i];
+        }
+        ss << " ] }";
+        return ss.str().size();
+    }
+
+    size_t
+    serialize_with_snprintf(const std::vector<double> &values, BufferSink &sink)
+    {
+        sink.clear();
+        sink.write("{ \"values\" : [ ", 15);
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            if (i > 0)
+            {
+                sink.write(", ", 2);
+            }
+            char buffer[32];
+            int  n = std::snprintf(buffer, sizeof(buffer), "%.17g", values[i]);
+            sink.write(buffer, static_cast<size_t>(n));
+        }
+        sink.write(" ] }", 4);
+        return sink.size();
+    }
+
+    template <typename T>
+    size_t
+    serialize_with_json_writer(const std::vector<T> &values, BufferSink &sink)
+    {
+        sink.clear();
+        {
+            basic_json_writer writer{sink};
+            writer << NVP{"values", values};
+        }
+        return sink.size();
+    }
+} // namespace
+
+int
+main()
+{
+    std::mt19937_64                        rng{42};
+    std::uniform_real_distribution<double> double_distribution{-1e6, 1e6};
+    std::uniform_int_distribution<int>     int_distribution{-1'000'000'000, 1'000'000'000};
+
+    std::vector<double> doubles(n_numbers);
+    std::vector<int>    ints(n_numbers);
+    for (size_t i = 0; i < n_numbers; ++i)
+    {
+        doubles[i] = double_distribution(rng);
+        ints[i]    = int_distribution(rng);
+    }
+
+    BufferSink sink;
+    throughput::print_header();
+    throughput::run("doubles: ostream (precision 6, lossy)", n_iterations,
+                    [&]() { return serialize_with_ostream(doubles, 6); });
+    throughput::run("doubles: ostream (precision 17)", n_iterations,
+                    [&]() { return serialize_with_ostream(doubles, 17); });
+    throughput::run("doubles: snprintf %.17g", n_iterations, [&]() { return serialize_with_snprintf(doubles, sink); });
+    throughput::run("doubles: JSONWriter to_chars shortest", n_iterations,
+                    [&]() { return serialize_with_json_writer(doubles, sink); });
+
+    throughput::run("ints: ostream", n_iterations, [&]() { return serialize_with_ostream(ints, 6); });
+    throughput::run("ints: JSONWriter to_chars", n_iterations,
+                    [&]() { return serialize_with_json_writer(ints, sink); });
+    return 0;
+}
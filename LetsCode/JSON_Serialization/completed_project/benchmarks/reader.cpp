@@ -0,0 +1,123 @@
+// Benchmarks the JSONReader on arrays of Person objects produced by the JSONWriter: pulling the events with next()
+// and pushing them to a handler with parse(), for compact strings (zero-copy) and strings with escape sequences (which
+// are decoded into the reader's buffer).
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../JSONReader.h"
+#include "../JSONWriter.h"
+#include "../OutputSinks.h"
+#include "../TestTypes.h"
+#include "Throughput.h"
+
+namespace
+{
+    constexpr size_t n_objects    = 200'000;
+    constexpr size_t n_iterations = 10;
+
+    /// Touches every event, so the parsing can't be optimized away.
+    struct CountingHandler
+    {
+        size_t n_events     = 0;
+        size_t string_bytes = 0;
+
+        void
+        begin_object()
+        {
+            ++n_events;
+        }
+        void
+        end_object()
+        {
+            ++n_events;
+        }
+        void
+        begin_array()
+        {
+            ++n_events;
+        }
+        void
+        end_array()
+        {
+            ++n_events;
+        }
+        void
+        key(std::string_view s)
+        {
+            string_bytes += s.size();
+        }
+        void
+        string(std::string_view s)
+        {
+            string_bytes += s.size();
+        }
+        void
+        number(std::string_view s)
+        {
+            string_bytes += s.size();
+        }
+        void
+        boolean(bool)
+        {
+            ++n_events;
+        }
+        void
+        null()
+        {
+            ++n_events;
+        }
+    };
+
+    std::string
+    make_json(const std::string &street_prefix)
+    {
+        std::vector<Person> people;
+        for (size_t i = 0; i < n_objects; ++i)
+        {
+            people.push_back(Person{"person " + std::to_string(i),
+                                    Address{street_prefix + std::to_string(i % 997), static_cast<int>(i % 300)}});
+        }
+        BufferSink sink;
+        {
+            basic_json_writer writer{sink};
+            writer << nvp<"people">(people);
+        }
+        return std::string(sink.view());
+    }
+
+    void
+    benchmark_read(const std::string &name, const std::string &json)
+    {
+        throughput::run(name + ", next()", n_iterations, [&]() {
+            JSONReader reader{json};
+            size_t     n_strings = 0;
+            for (JSONEvent event = reader.next(); event != JSONEvent::end_of_input; event = reader.next())
+            {
+                n_strings += event == JSONEvent::string;
+            }
+            throughput::do_not_optimize(n_strings);
+            return json.size();
+        });
+        throughput::run(name + ", parse(handler)", n_iterations, [&]() {
+            CountingHandler handler;
+            JSONReader      reader{json};
+            reader.parse(handler);
+            throughput::do_not_optimize(handler.string_bytes);
+            return json.size();
+        });
+    }
+} // namespace
+
+int
+main()
+{
+    std::string plain   = make_json("street ");
+    std::string escaped = make_json("\"quoted\"\tstreet ");
+
+    throughput::print_header();
+    benchmark_read("Person array", plain);
+    benchmark_read("Person array, escaped strings", escaped);
+    return 0;
+}
@@ -0,0 +1,111 @@
+// Benchmarks the serializers generated from reflection tables (json_fields) against hand-written serializers with
+// runtime keys (NVP) and compile-time keys (nvp<"key">), for vectors of nested Person/Address objects.
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "../JSONReflection.h"
+#include "../JSONWriter.h"
+#include "../OutputSinks.h"
+#include "../TestTypes.h"
+#include "Throughput.h"
+
+namespace
+{
+    constexpr size_t n_objects    = 100'000;
+    constexpr size_t n_iterations = 10;
+
+    struct StaticAddress
+    {
+        std::string street_name;
+        int         house_number;
+    };
+
+    struct StaticPerson
+    {
+        std::string   name;
+        StaticAddress address;
+    };
+
+    template <typename SINK>
+    void
+    serialize(basic_json_writer<SINK> &writer, const StaticAddress &a)
+    {
+        writer << nvp<"street_name">(a.street_name) << nvp<"house_number">(a.house_number);
+    }
+
+    template <typename SINK>
+    void
+    serialize(basic_json_writer<SINK> &writer, const StaticPerson &p)
+    {
+        writer << nvp<"name">(p.name) << nvp<"address">(p.address);
+    }
+
+    struct ReflectedAddress
+    {
+        std::string street_name;
+        int         house_number;
+    };
+
+    struct ReflectedPerson
+    {
+        std::string      name;
+        ReflectedAddress address;
+    };
+} // namespace
+
+template <>
+struct json_fields<ReflectedAddress>
+{
+    static constexpr std::tuple value{field<"street_name", &ReflectedAddress::street_name>{},
+                                      field<"house_number", &ReflectedAddress::house_number>{}};
+};
+
+template <>
+struct json_fields<ReflectedPerson>
+{
+    static constexpr std::tuple value{field<"name", &ReflectedPerson::name>{},
+                                      field<"address", &ReflectedPerson::address>{}};
+};
+
+namespace
+{
+    template <typename T>
+    void
+    benchmark_serialize(const std::string &name, const std::vector<T> &objects)
+    {
+        BufferSink sink;
+        throughput::run(name, n_iterations, [&]() {
+            sink.clear();
+            {
+                basic_json_writer writer{sink};
+                writer << nvp<"objects">(objects);
+            }
+            return sink.size();
+        });
+    }
+} // namespace
+
+int
+main()
+{
+    std::vector<Person>          people;
+    std::vector<StaticPerson>    static_people;
+    std::vector<ReflectedPerson> reflected_people;
+    for (size_t i = 0; i < n_objects; ++i)
+    {
+        std::string name   = "person " + std::to_string(i);
+        std::string street = "street " + std::to_string(i % 997);
+        int         number = static_cast<int>(i % 300);
+        people.push_back(Person{name, Address{street, number}});
+        static_people.push_back(StaticPerson{name, StaticAddress{street, number}});
+        reflected_people.push_back(ReflectedPerson{name, ReflectedAddress{street, number}});
+    }
+
+    throughput::print_header();
+    benchmark_serialize("Person, hand-written, runtime keys (NVP)", people);
+    benchmark_serialize("Person, hand-written, compile-time keys (nvp<>)", static_people);
+    benchmark_serialize("Person, generated from json_fields", reflected_people);
+    return 0;
+}
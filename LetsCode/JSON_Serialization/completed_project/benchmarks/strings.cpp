@@ -0,0 +1,106 @@
+// Benchmarks string-heavy payloads: Person objects with short names and long street names (a few of them containing
+// characters that need escaping). Compares std::quoted on a stream (the former writer) with JSONWriter using the
+// scalar, SSE2 and AVX2 searches for characters that need escaping, and the runtime-dispatched default.
+
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../JSONEscape.h"
+#include "../JSONWriter.h"
+#include "../OutputSinks.h"
+#include "../TestTypes.h"
+#include "Throughput.h"
+
+namespace
+{
+    constexpr size_t n_people     = 100'000;
+    constexpr size_t n_iterations = 10;
+
+    std::vector<Person>
+    make_people(size_t street_name_length)
+    {
+        std::vector<Person> people;
+        people.reserve(n_people);
+        for (size_t i = 0; i < n_people; ++i)
+        {
+            std::string street_name(street_name_length, 'x');
+            for (size_t j = 0; j < street_name_length; j += 7)
+            {
+                street_name[j] = ' ';
+            }
+            if (i % 10 == 0)
+            {
+                street_name[street_name_length / 2] = '"';
+            }
+            people.push_back(Person{"person " + std::to_string(i), Address{street_name, static_cast<int>(i % 300)}});
+        }
+        return people;
+    }
+
+    size_t
+    serialize_with_quoted(const std::vector<Person> &people)
+    {
+        std::ostringstream ss;
+        for (const auto &p : people)
+        {
+            ss << std::quoted(p.name) << std::quoted(p.address.street_name);
+        }
+        return ss.str().size();
+    }
+
+    size_t
+    serialize_with_escaper(const std::vector<Person> &people, BufferSink &sink, json_escape::find_escape_fn find)
+    {
+        sink.clear();
+        for (const auto &p : people)
+        {
+            sink.put('"');
+            json_escape::write_escaped(sink, p.name, find);
+            sink.put('"');
+            sink.put('"');
+            json_escape::write_escaped(sink, p.address.street_name, find);
+            sink.put('"');
+        }
+        return sink.size();
+    }
+
+    void
+    benchmark_strings(size_t street_name_length)
+    {
+        const auto  people = make_people(street_name_length);
+        BufferSink  sink;
+        std::string suffix = " (street_name " + std::to_string(street_name_length) + " bytes)";
+
+        throughput::run("std::quoted" + suffix, n_iterations, [&]() { return serialize_with_quoted(people); });
+        throughput::run("escaper scalar" + suffix, n_iterations,
+                        [&]() { return serialize_with_escaper(people, sink, json_escape::find_escape_scalar); });
+#ifdef BOQ_JSON_ESCAPE_X86
+        throughput::run("escaper SSE2" + suffix, n_iterations,
+                        [&]() { return serialize_with_escaper(people, sink, json_escape::find_escape_sse2); });
+        if (__builtin_cpu_supports("avx2"))
+        {
+            throughput::run("escaper AVX2" + suffix, n_iterations,
+                            [&]() { return serialize_with_escaper(people, sink, json_escape::find_escape_avx2); });
+        }
+#endif
+        throughput::run("JSONWriter (dispatched)" + suffix, n_iterations, [&]() {
+            sink.clear();
+            {
+                basic_json_writer writer{sink};
+                writer << NVP{"people", people};
+            }
+            return sink.size();
+        });
+    }
+} // namespace
+
+int
+main()
+{
+    throughput::print_header();
+    benchmark_strings(16);
+    benchmark_strings(256);
+    return 0;
+}
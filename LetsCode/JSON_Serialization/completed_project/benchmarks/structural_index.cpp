@@ -0,0 +1,116 @@
+// Benchmarks the two-stage parsing on a synthetic document of more than 100 MB: stage 1 (structural index) with each
+// classification implementation, stage 2 (walking the index), and both stages together against the reader scanning
+// the input byte by byte.
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "../JSONReader.h"
+#include "../JSONStructuralIndex.h"
+#include "../JSONWriter.h"
+#include "../OutputSinks.h"
+#include "../TestTypes.h"
+#include "Throughput.h"
+
+namespace
+{
+    constexpr size_t min_size     = 100'000'000;
+    constexpr size_t n_iterations = 5;
+
+    /// Arrays of Persons (some with escaped strings) and numbers, until the document is at least min_size bytes.
+    std::string
+    make_document()
+    {
+        BufferSink sink{min_size + min_size / 10};
+        {
+            basic_json_writer writer{sink};
+            for (size_t chunk = 0; sink.size() < min_size; ++chunk)
+            {
+                std::vector<Person> people;
+                std::vector<double> values;
+                for (size_t i = 0; i < 1000; ++i)
+                {
+                    std::string name = "person " + std::to_string(i);
+                    if (i % 10 == 0)
+                    {
+                        name += " \"quoted\"\n";
+                    }
+                    people.push_back(Person{name, Address{"street " + std::to_string(i % 997), static_cast<int>(i)}});
+                    values.push_back(static_cast<double>(i) * 0.001);
+                }
+                writer << NVP{"people" + std::to_string(chunk), people};
+                writer << NVP{"values" + std::to_string(chunk), values};
+            }
+        }
+        return std::string(sink.view());
+    }
+
+    size_t
+    walk(JSONReader &reader)
+    {
+        size_t n_events = 0;
+        while (reader.next() != JSONEvent::end_of_input)
+        {
+            ++n_events;
+        }
+        return n_events;
+    }
+} // namespace
+
+int
+main()
+{
+    const std::string json = make_document();
+    std::printf("document: %zu bytes\n", json.size());
+
+    throughput::print_header();
+    throughput::run("stage 1, scalar", n_iterations, [&]() {
+        StructuralIndex index{json, json_index::classify_scalar};
+        throughput::do_not_optimize(index.size());
+        return json.size();
+    });
+#ifdef BOQ_JSON_INDEX_X86
+    throughput::run("stage 1, SSE2", n_iterations, [&]() {
+        StructuralIndex index{json, json_index::classify_sse2};
+        throughput::do_not_optimize(index.size());
+        return json.size();
+    });
+    if (__builtin_cpu_supports("avx2"))
+    {
+        throughput::run("stage 1, AVX2", n_iterations, [&]() {
+            StructuralIndex index{json, json_index::classify_avx2};
+            throughput::do_not_optimize(index.size());
+            return json.size();
+        });
+    }
+#endif
+
+    {
+        StructuralIndex index{json};
+        std::printf("index: %zu tokens\n", index.size());
+        // without the page faults of a new allocation
+        throughput::run("stage 1, reusing the index", n_iterations, [&]() {
+            index.build(json);
+            throughput::do_not_optimize(index.size());
+            return json.size();
+        });
+        throughput::run("stage 2, walking the index", n_iterations, [&]() {
+            JSONReader reader{json, index};
+            throughput::do_not_optimize(walk(reader));
+            return json.size();
+        });
+        throughput::run("stage 1 + stage 2, reusing the index", n_iterations, [&]() {
+            index.build(json);
+            JSONReader reader{json, index};
+            throughput::do_not_optimize(walk(reader));
+            return json.size();
+        });
+    }
+    throughput::run("single stage (byte by byte)", n_iterations, [&]() {
+        JSONReader reader{json};
+        throughput::do_not_optimize(walk(reader));
+        return json.size();
+    });
+    return 0;
+}
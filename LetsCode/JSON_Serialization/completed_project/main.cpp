@@ -1,10 +1,34 @@
 #include <gtest/gtest.h>
 
 #include <array>
-#include <iomanip>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <limits>
+#include <random>
 #include <sstream>
-#include <type_traits>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include "AllocationTracker.h"
+#include "Arena.h"
+#include "JSONDeserialize.h"
+#include "JSONDocument.h"
+#include "JSONNumber.h"
+#include "JSONEscape.h"
+#include "JSONReader.h"
+#include "JSONStructuralIndex.h"
+#include "JSONWriter.h"
+#include "MappedFile.h"
+#include "OutputSinks.h"
+#include "TestTypes.h"
 
 // This project was completed in a live test driven development demonstration as part of the LetsCode series on the
 // BitsOfQ YouTube channel.
@@ -18,172 +42,12 @@
 // serialize list-like type (e.g std::vector) to json array
 // allow specifying members of a struct/class
 // compile time error should be given when a type can't be serialized
-
-/// Used for testing custom type serialization
-struct Address
-{
-    std::string street_name;
-    int         house_number;
-};
-
-/// Used for testing custom type serialization
-struct Person
-{
-    std::string name;
-    Address     address;
-};
-
-/// Specifies a name-value pair. Used when streaming to a JSONWriter instance.
-template <typename T>
-struct NVP
-{
-    const std::string &name;
-    const T           &value;
-};
-
-/// Convenience function to create name-value pairs
-template <typename T>
-NVP<T>
-nvp(const std::string &name, const T &value)
-{
-    return NVP<T>{name, value};
-}
-
-/// Deduction guide te ensure the NVP struct can be initialized using the uniform initializer syntax without having to
-/// specify template parameters.
-template <typename T>
-NVP(std::string, T) -> NVP<T>;
-
-/// Concept which specifies the category of types that should be serialized to a JSON list / array.
-/// We define a list to be a type that support indexing and a .begin() and .end() operator. Furthermore, since string
-/// types often also fit this description, we explicitly exclude any string-like types from the concept.
-template <typename T>
-concept JSONListLike = requires(T t) {
-    t[0];
-    t.begin();
-    t.end();
-    requires !std::is_convertible_v<T, std::string>;
-};
-
-/// The JSONWriter class can be used to serialize data to json and output it to a stream.
-/// Data should be passed to instances of the class using the streaming operator and while wrapped in an NVP (name-value
-/// pair) struct.
-/// The data is flushed to the stream when the writer instance goes out of scope, following the RAII principle.
-class JSONWriter
-{
-    // type trait used to check if a type is an nvp. Used for improved error reporting.
-    template <typename T>
-    struct is_nvp : std::false_type
-    {
-    };
-
-    template <typename T>
-    struct is_nvp<NVP<T>> : std::true_type
-    {
-    };
-
-    template <typename T>
-    static constexpr bool is_nvp_v = is_nvp<T>::value;
-
-  public:
-    explicit JSONWriter(std::ostream &stream) : m_stream(stream)
-    {
-        m_stream << "{ ";
-    }
-    ~JSONWriter()
-    {
-        m_stream << " }";
-    }
-
-    template <typename T>
-    JSONWriter &
-    operator<<(const T &)
-    {
-        static_assert(is_nvp_v<T>, "To serialize to JSON, pass name-value pairs using the NVP struct");
-        return *this;
-    }
-
-    template <typename T>
-    JSONWriter &
-    operator<<(const NVP<T> &nvp)
-    {
-        if (!m_first_nvp)
-        {
-            m_stream << ", ";
-        }
-        m_stream << std::boolalpha << "\"" << nvp.name << "\" : ";
-        serialize_value(nvp.value);
-        m_first_nvp = false;
-        return *this;
-    }
-
-  private:
-    std::ostream &m_stream;
-    bool          m_first_nvp = true;
-
-    template <typename T>
-    void
-    serialize_value(const T &t)
-    {
-        m_stream << t;
-    }
-
-    template <typename T>
-        requires(std::is_convertible_v<T, std::string>)
-    void
-    serialize_value(const T &t)
-    {
-        m_stream << std::quoted(t);
-    }
-
-    template <JSONListLike L>
-    void
-    serialize_value(const L &list)
-    {
-        bool is_first = true;
-        m_stream << "[ ";
-        for (const auto &e : list)
-        {
-            if (!is_first)
-            {
-                m_stream << ", ";
-            }
-            serialize_value(e);
-            is_first = false;
-        }
-        m_stream << " ]";
-    }
-
-    template <typename T>
-        requires(std::is_class_v<T> && !std::is_convertible_v<T, std::string> && !JSONListLike<T>)
-    void
-    serialize_value(const T &t)
-    {
-        static_assert(
-            requires(JSONWriter &writer) { serialize(writer, t); },
-            "Serialization of custom classes requires a serialize overload to be defined");
-        m_first_nvp = true;
-        m_stream << "{ ";
-        serialize(*this, t);
-        m_stream << " }";
-    }
-};
-
-/// Serialization definition for custom classes used in the tests ///
-
-void
-serialize(JSONWriter &writer, const Address &a)
-{
-    writer << NVP{"street_name", a.street_name};
-    writer << NVP{"house_number", a.house_number};
-}
-
-void
-serialize(JSONWriter &writer, const Person &p)
-{
-    writer << NVP{"name", p.name};
-    writer << NVP{"address", p.address};
-}
+// write to a stream, a contiguous buffer or a file descriptor
+// generate serializers from a declarative list of (name, member pointer) fields
+// read JSON from a string or a memory mapped file as a sequence of events, without copying strings
+// deserialize JSON into builtin types, strings, lists and types with a list of fields
+// access single values of a document without parsing the rest of it
+// read numbers back exactly as they were written
 
 /////////////////////////////// Tests ///////////////////////////////
 
@@ -238,6 +102,62 @@ TEST(JSONWriterTests, NVPWithDoubleIsCorrectlySerialized)
     EXPECT_EQ(ss.str(), R"({ "hello" : 42.5 })");
 }
 
+TEST(JSONWriterTests, DoublesAreSerializedWithShortestRoundTripRepresentation)
+{
+    auto serialized = [](auto value) {
+        BufferSink sink;
+        {
+            basic_json_writer writer{sink};
+            writer << NVP{"x", value};
+        }
+        return std::string{sink.view()};
+    };
+    EXPECT_EQ(serialized(0.1), R"({ "x" : 0.1 })");
+    EXPECT_EQ(serialized(1234567.0), R"({ "x" : 1234567 })");
+    EXPECT_EQ(serialized(1e300), R"({ "x" : 1e+300 })");
+    EXPECT_EQ(serialized(-0.000123), R"({ "x" : -0.000123 })");
+    EXPECT_EQ(serialized(0.1F), R"({ "x" : 0.1 })");
+    EXPECT_EQ(serialized(1.0 / 3.0), R"({ "x" : 0.3333333333333333 })");
+
+    std::mt19937_64 rng{42};
+    for (int i = 0; i < 10'000; ++i)
+    {
+        double value;
+        do
+        {
+            uint64_t bits = rng();
+            std::memcpy(&value, &bits, sizeof(value));
+        } while (!std::isfinite(value));
+
+        std::string json   = serialized(value);
+        std::string number = json.substr(8, json.size() - 8 - 2); // strip { "x" : and  }
+        EXPECT_EQ(std::strtod(number.c_str(), nullptr), value) << number;
+    }
+}
+
+TEST(JSONWriterTests, NonFiniteDoublesAreSerializedAsNull)
+{
+    std::stringstream ss;
+    {
+        JSONWriter writer{ss};
+        writer << NVP{"nan", std::nan("")};
+        writer << NVP{"inf", std::numeric_limits<double>::infinity()};
+        writer << NVP{"list", std::vector<double>{-std::numeric_limits<double>::infinity(), 1.5}};
+    }
+    EXPECT_EQ(ss.str(), R"({ "nan" : null, "inf" : null, "list" : [ null, 1.5 ] })");
+}
+
+TEST(JSONWriterTests, IntegerLimitsAreSerializedCorrectly)
+{
+    std::stringstream ss;
+    {
+        JSONWriter writer{ss};
+        writer << NVP{"min", std::numeric_limits<int64_t>::min()};
+        writer << NVP{"max", std::numeric_limits<uint64_t>::max()};
+    }
+    EXPECT_EQ(ss.str(), R"({ "min" : -9223372036854775808, "max" : 18446744073709551615 })");
+}
+
 TEST(JSONWriterTests, MultipleNVPsAreSerializedCorrectly)
 {
     std::stringstream ss;
@@ -322,6 +242,320 @@ TEST(JSONWriterTests, NVPWithSTDArrayIsCorrectlySerialized)
     EXPECT_EQ(ss.str(), R"({ "list" : [ 1, 2, 3, 4 ] })");
 }
 
+TEST(JSONWriterTests, StreamFormattingFlagsDontAffectOutput)
+{
+    std::stringstream ss;
+    ss << std::noboolalpha << std::hex << std::showpos;
+    {
+        JSONWriter writer{ss};
+        writer << NVP{"flag", true};
+        writer << NVP{"number", 42};
+    }
+    EXPECT_EQ(ss.str(), R"({ "flag" : true, "number" : 42 })");
+}
+
+TEST(JSONWriterTests, QuotesAndBackslashesInStringsAreEscaped)
+{
+    std::stringstream ss;
+    {
+        JSONWriter writer{ss};
+        writer << NVP{"hello", std::string{R"(say "hi" \ bye)"}};
+    }
+    EXPECT_EQ(ss.str(), R"({ "hello" : "say \"hi\" \\ bye" })");
+}
+
+TEST(JSONWriterTests, ControlCharactersInStringsAreEscaped)
+{
+    std::stringstream ss;
+    {
+        JSONWriter writer{ss};
+        writer << NVP{"hello", std::string{"a\nb\tc\r\b\f\x01\x1f\x7f \xc3\xa9"}};
+        writer << NVP{"zero", std::string{"x\0y", 3}};
+    }
+    EXPECT_EQ(ss.str(), "{ \"hello\" : \"a\\nb\\tc\\r\\b\\f\\u0001\\u001f\x7f \xc3\xa9\", \"zero\" : \"x\\u0000y\" }");
+}
+
+TEST(JSONWriterTests, RuntimeKeysAreEscapedLikeCompileTimeKeys)
+{
+    std::stringstream runtime_keys;
+    {
+        JSONWriter writer{runtime_keys};
+        writer << NVP{"a\"b", 1} << NVP{"c\\d", 2} << NVP{"e\nf\x01", 3};
+    }
+    EXPECT_EQ(runtime_keys.str(), R"({ "a\"b" : 1, "c\\d" : 2, "e\nf\u0001" : 3 })");
+
+    std::stringstream static_keys;
+    {
+        JSONWriter writer{static_keys};
+        writer << nvp<"a\"b">(1) << nvp<"c\\d">(2) << nvp<"e\nf\x01">(3);
+    }
+    EXPECT_EQ(runtime_keys.str(), static_keys.str());
+}
+
+TEST(JSONWriterTests, AllEscapeSearchImplementationsAgree)
+{
+    std::vector<json_escape::find_escape_fn> implementations{json_escape::find_escape_scalar};
+#ifdef BOQ_JSON_ESCAPE_X86
+    implementations.push_back(json_escape::find_escape_sse2);
+    if (__builtin_cpu_supports("avx2"))
+    {
+        implementations.push_back(json_escape::find_escape_avx2);
+    }
+#endif
+
+    // strings of all lengths up to 100 with at most one special character at every possible position, so the
+    // vectorized searches are tested in their loops as well as in their tails
+    const std::string specials = std::string{"\"\\\n\x1f"} + std::string(1, '\0');
+    for (size_t length = 0; length <= 100; ++length)
+    {
+        for (size_t position = 0; position <= length; ++position)
+        {
+            for (char special : specials)
+            {
+                std::string s(length, 'a');
+                s.append("\x80\xff ~"); // bytes that don't need escaping, including ones above 0x7f
+                if (position < length)
+                {
+                    s[position] = special;
+                }
+                size_t expected = position < length ? position : s.size();
+                for (auto find : implementations)
+                {
+                    ASSERT_EQ(find(s.data(), s.size()), expected) << "length " << length << ", position " << position;
+                }
+            }
+        }
+    }
+}
+
+TEST(JSONWriterTests, NestedStructIsSerializedToBufferSink)
+{
+    BufferSink sink;
+    {
+        basic_json_writer writer{sink};
+        static_assert(std::is_same_v<decltype(writer), basic_json_writer<BufferSink &>>);
+        writer << NVP{"hello", Person{"Bob", Address{"some_street", 42}}};
+        writer << NVP{"list", std::vector<int>{1, 2}};
+    }
+    EXPECT_EQ(
+        sink.view(),
+        R"({ "hello" : { "name" : "Bob", "address" : { "street_name" : "some_street", "house_number" : 42 } }, "list" : [ 1, 2 ] })");
+}
+
+TEST(JSONWriterTests, SerializingToAReservedBufferSinkDoesNotAllocate)
+{
+    BufferSink       sink{1024};
+    Person           person{"Bob", Address{"some_street", 42}};
+    std::vector<int> list{1, 2};
+    std::string      text{"a\"b"};
+    bits_of_q::AllocationTracker::reset();
+    {
+        basic_json_writer writer{sink};
+        writer << NVP{"hello", person} << nvp<"list">(list) << NVP{"pi", 3.14} << NVP{"text", text};
+    }
+    EXPECT_ALLOCS_LE(0);
+    EXPECT_EQ(
+        sink.view(),
+        R"({ "hello" : { "name" : "Bob", "address" : { "street_name" : "some_street", "house_number" : 42 } }, "list" : [ 1, 2 ], "pi" : 3.14, "text" : "a\"b" })");
+}
+
+TEST(JSONWriterTests, BufferSinkGrowsAndKeepsContent)
+{
+    BufferSink  sink{4};
+    std::string expected;
+    for (int i = 0; i < 1000; ++i)
+    {
+        std::string part = std::to_string(i) + ",";
+        sink.write(part.data(), part.size());
+        sink.put(' ');
+        expected += part + " ";
+    }
+    EXPECT_EQ(sink.view(), expected);
+
+    sink.clear();
+    EXPECT_EQ(sink.size(), 0U);
+
+    // the buffer is reused after clear and grows geometrically, from 8192 to 32768 bytes
+    bits_of_q::AllocationTracker::reset();
+    for (size_t i = 0; i < 4 * expected.size(); ++i)
+    {
+        sink.put('x');
+    }
+    EXPECT_ALLOCS_LE(2);
+}
+
+TEST(JSONWriterTests, BufferSinkWithZeroCapacityGrows)
+{
+    BufferSink sink{0};
+    sink.write("", 0);
+    sink.put('x');
+    sink.write("yz", 2);
+    EXPECT_EQ(sink.view(), "xyz");
+
+    BufferSink empty;
+    empty.write("", 0);
+    EXPECT_EQ(empty.size(), 0U);
+}
+
+#ifdef BOQ_HAS_FD_SINK
+TEST(JSONWriterTests, FdSinkWithZeroBufferSizeWritesEverything)
+{
+    std::FILE *file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    {
+        FdSink sink{fileno(file), 0};
+        sink.put('a');
+        sink.put('b');
+        sink.write("cd", 2);
+        sink.put('e');
+        sink.flush();
+    }
+
+    std::string content(10, '\0');
+    std::rewind(file);
+    content.resize(std::fread(content.data(), 1, content.size(), file));
+    std::fclose(file);
+    EXPECT_EQ(content, "abcde");
+}
+
+TEST(JSONWriterTests, NestedStructIsSerializedToFdSink)
+{
+    std::FILE *file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    {
+        FdSink sink{fileno(file), 16}; // smaller than the output, so the buffer is flushed while writing
+        bits_of_q::AllocationTracker::reset();
+        {
+            basic_json_writer writer{sink};
+            writer << NVP{"hello", Person{"Bob", Address{"some_street", 42}}};
+        }
+        sink.flush();
+        EXPECT_ALLOCS_LE(0);
+    }
+
+    std::string content(200, '\0');
+    std::rewind(file);
+    content.resize(std::fread(content.data(), 1, content.size(), file));
+    std::fclose(file);
+    EXPECT_EQ(content,
+              R"({ "hello" : { "name" : "Bob", "address" : { "street_name" : "some_street", "house_number" : 42 } } })");
+}
+
+TEST(JSONWriterTests, FdSinkThrowsWhenWriteFails)
+{
+    FdSink sink{-1};
+    sink.put('x');
+    EXPECT_THROW(sink.flush(), std::system_error);
+}
+#endif
+
+/// Used for testing serialization with compile-time keys. Its serializer is written against JSONWriter, the way
+/// serializers were written before the writer was templated on its sink, and only works when writing to a stream.
+struct Point
+{
+    int x;
+    int y;
+};
+
+void
+serialize(JSONWriter &writer, const Point &p)
+{
+    writer << nvp<"x">(p.x) << nvp<"y">(p.y);
+}
+
+TEST(JSONWriterTests, JSONWriterWritesToAStream)
+{
+    static_assert(std::is_same_v<JSONWriter, basic_json_writer<OStreamSink>>);
+
+    std::stringstream ss;
+    {
+        JSONWriter writer{ss};
+        static_assert(std::is_same_v<decltype(writer), JSONWriter>);
+        writer << NVP{"point", Point{1, 2}};
+    }
+    EXPECT_EQ(ss.str(), R"({ "point" : { "x" : 1, "y" : 2 } })");
+}
+
+TEST(JSONWriterTests, CompileTimeKeyFragmentsAreQuotedAndEscaped)
+{
+    static_assert(StaticNVP<"hello", int>::first_fragment == R"("hello" : )");
+    static_assert(StaticNVP<"hello", int>::next_fragment == R"(, "hello" : )");
+    static_assert(StaticNVP<"say \"hi\"\n", int>::first_fragment == R"("say \"hi\"\n" : )");
+}
+
+TEST(JSONWriterTests, NVPsWithCompileTimeKeysAreSerializedCorrectly)
+{
+    std::stringstream ss;
+    {
+        JSONWriter writer{ss};
+        writer << nvp<"hello">(42) << nvp<"name">(std::string{"Bob"});
+        writer << NVP{"runtime", true};
+        writer << nvp<"points">(std::vector<Point>{Point{1, 2}, Point{3, 4}});
+    }
+    EXPECT_EQ(ss.str(),
+              R"({ "hello" : 42, "name" : "Bob", "runtime" : true, "points" : [ { "x" : 1, "y" : 2 }, { "x" : 3, "y" : 4 } ] })");
+}
+
+/// Used for testing serializers generated from reflection tables, the same as Person/Address
+struct ReflectedAddress
+{
+    std::string street_name;
+    int         house_number;
+
+    bool operator==(const ReflectedAddress &) const = default;
+};
+
+struct ReflectedPerson
+{
+    std::string      name;
+    ReflectedAddress address;
+
+    bool operator==(const ReflectedPerson &) const = default;
+};
+
+template <>
+struct json_fields<ReflectedAddress>
+{
+    static constexpr std::tuple value{field<"street_name", &ReflectedAddress::street_name>{},
+                                      field<"house_number", &ReflectedAddress::house_number>{}};
+};
+
+template <>
+struct json_fields<ReflectedPerson>
+{
+    static constexpr std::tuple value{field<"name", &ReflectedPerson::name>{},
+                                      field<"address", &ReflectedPerson::address>{}};
+};
+
+TEST(JSONWriterTests, ReflectedTypesAreFlattenedIntoMergedFragments)
+{
+    using plan = json_detail::serializer_plan<ReflectedPerson>;
+    static_assert(plan::n_leaves == 3);
+    static_assert(plan::fragment(0) == R"({ "name" : )");
+    static_assert(plan::fragment(1) == R"(, "address" : { "street_name" : )");
+    static_assert(plan::fragment(2) == R"(, "house_number" : )");
+    static_assert(plan::fragment(3) == " } }");
+}
+
+TEST(JSONWriterTests, ReflectedTypesAreSerializedLikeHandWrittenSerializers)
+{
+    std::stringstream expected;
+    {
+        JSONWriter writer{expected};
+        writer << NVP{"hello", Person{"Bob", Address{"some_street", 42}}};
+        writer << NVP{"list", std::vector<Person>{Person{"A\"B", Address{"x", 1}}, Person{"C", Address{"y", 2}}}};
+    }
+
+    BufferSink sink;
+    {
+        basic_json_writer writer{sink};
+        writer << NVP{"hello", ReflectedPerson{"Bob", ReflectedAddress{"some_street", 42}}};
+        writer << nvp<"list">(std::vector<ReflectedPerson>{ReflectedPerson{"A\"B", ReflectedAddress{"x", 1}},
+                                                           ReflectedPerson{"C", ReflectedAddress{"y", 2}}});
+    }
+    EXPECT_EQ(sink.view(), expected.str());
+}
+
 struct bla
 {
     int  a;
@@ -340,3 +574,646 @@ struct bla
   JSONWriter writer{std::cout};
   writer << 5;
 }*/
+
+/// Records the events of a JSONReader as text, e.g. "{ key:name string:Bob }"
+struct EventRecorder
+{
+    std::string events;
+
+    void
+    begin_object()
+    {
+        events += "{ ";
+    }
+    void
+    end_object()
+    {
+        events += "} ";
+    }
+    void
+    begin_array()
+    {
+        events += "[ ";
+    }
+    void
+    end_array()
+    {
+        events += "] ";
+    }
+    void
+    key(std::string_view s)
+    {
+        events += "key:" + std::string(s) + " ";
+    }
+    void
+    string(std::string_view s)
+    {
+        events += "string:" + std::string(s) + " ";
+    }
+    void
+    number(std::string_view s)
+    {
+        events += "number:" + std::string(s) + " ";
+    }
+    void
+    boolean(bool b)
+    {
+        events += b ? "true " : "false ";
+    }
+    void
+    null()
+    {
+        events += "null ";
+    }
+};
+
+std::string
+read_events(std::string_view json, bool with_structural_index = false)
+{
+    EventRecorder recorder;
+    if (with_structural_index)
+    {
+        StructuralIndex index{json};
+        JSONReader      reader{json, index};
+        reader.parse(recorder);
+    }
+    else
+    {
+        JSONReader reader{json};
+        reader.parse(recorder);
+    }
+    return recorder.events;
+}
+
+TEST(JSONReaderTests, ReadsTheOutputOfTheWriter)
+{
+    BufferSink sink;
+    {
+        basic_json_writer writer{sink};
+        writer << NVP{"hello", Person{"Bob", Address{"some_street", 42}}};
+        writer << NVP{"list", std::vector<double>{1.5, -2e-10}};
+        writer << NVP{"flag", false};
+    }
+    EXPECT_EQ(read_events(sink.view()),
+              "{ key:hello { key:name string:Bob key:address { key:street_name string:some_street key:house_number "
+              "number:42 } } key:list [ number:1.5 number:-2e-10 ] key:flag false } ");
+}
+
+TEST(JSONReaderTests, ReadsAllValueTypes)
+{
+    EXPECT_EQ(read_events(" [true,false,null,{},[],\"\",0,-0.5e+3,{\"a\":[[1]]}]\n"),
+              "[ true false null { } [ ] string: number:0 number:-0.5e+3 { key:a [ [ number:1 ] ] } ] ");
+    EXPECT_EQ(read_events("7"), "number:7 ");
+}
+
+TEST(JSONReaderTests, StringsWithoutEscapesAreViewsIntoTheInput)
+{
+    std::string_view json = R"({ "name" : "Bob" })";
+    JSONReader       reader{json};
+    EXPECT_EQ(reader.next(), JSONEvent::begin_object);
+    EXPECT_EQ(reader.next(), JSONEvent::key);
+    EXPECT_EQ(reader.string_value().data(), json.data() + 3);
+    EXPECT_EQ(reader.next(), JSONEvent::string);
+    EXPECT_EQ(reader.string_value(), "Bob");
+    EXPECT_EQ(reader.string_value().data(), json.data() + 12);
+    EXPECT_EQ(reader.next(), JSONEvent::end_object);
+    EXPECT_EQ(reader.next(), JSONEvent::end_of_input);
+    EXPECT_EQ(reader.next(), JSONEvent::end_of_input);
+}
+
+TEST(JSONReaderTests, EscapeSequencesAreDecoded)
+{
+    std::string_view json = R"(["say \"hi\"\n\\/\/", "\u0041\u00e9\u20ac\ud83d\ude00\u0000x"])";
+    JSONReader       reader{json};
+    EXPECT_EQ(reader.next(), JSONEvent::begin_array);
+    EXPECT_EQ(reader.next(), JSONEvent::string);
+    EXPECT_EQ(reader.string_value(), "say \"hi\"\n\\//");
+    EXPECT_EQ(reader.next(), JSONEvent::string);
+    EXPECT_EQ(reader.string_value(), std::string_view("A\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80\0x", 12));
+}
+
+TEST(JSONReaderTests, EscapedStringsWrittenByTheWriterAreReadBack)
+{
+    std::string value;
+    for (int c = 1; c < 128; ++c)
+    {
+        value += static_cast<char>(c);
+    }
+    value += "\xC3\xA9";
+    BufferSink sink;
+    {
+        basic_json_writer writer{sink};
+        writer << NVP{"value", value};
+    }
+    JSONReader reader{sink.view()};
+    reader.next();
+    reader.next();
+    EXPECT_EQ(reader.next(), JSONEvent::string);
+    EXPECT_EQ(reader.string_value(), value);
+}
+
+TEST(JSONReaderTests, MalformedInputThrows)
+{
+    for (std::string_view json : {"", "{", "[1,]", "[1 2]", "{\"a\" 1}", "{\"a\":1,}", "{1:2}", "[}", "{]", "01",
+                                  "-", "1.", "1e", "+1", "tru", "nul", "\"abc", "\"a\tb\"", "\"\\x\"", "\"\\u12\"",
+                                  "\"\\ud800\"", "\"\\udc00\"", "[1] 2", "{} x", "truex", "[1x]", "[\"a\"x]",
+                                  "[nullnull]"})
+    {
+        EXPECT_THROW(read_events(json), JSONParseError) << json;
+        EXPECT_THROW(read_events(json, true), JSONParseError) << json;
+    }
+}
+
+TEST(JSONReaderTests, ParseErrorsReportTheOffset)
+{
+    try
+    {
+        read_events("[1, 2, x]");
+        FAIL();
+    }
+    catch (const JSONParseError &e)
+    {
+        EXPECT_EQ(e.offset(), 7U);
+    }
+}
+
+TEST(JSONReaderTests, PeekDoesNotConsumeTheEvent)
+{
+    JSONReader reader{R"(["a", 1])"};
+    EXPECT_EQ(reader.next(), JSONEvent::begin_array);
+    EXPECT_EQ(reader.peek(), JSONEvent::string);
+    EXPECT_EQ(reader.string_value(), "a");
+    EXPECT_EQ(reader.peek(), JSONEvent::string);
+    EXPECT_EQ(reader.next(), JSONEvent::string);
+    EXPECT_EQ(reader.next(), JSONEvent::number);
+    EXPECT_EQ(reader.string_value(), "1");
+}
+
+TEST(JSONReaderTests, SkipValueSkipsNestedValues)
+{
+    JSONReader reader{R"({ "a" : { "b" : [ 1, { "c" : [] } ], "d" : "e" }, "f" : 2, "g" : true })"};
+    EXPECT_EQ(reader.next(), JSONEvent::begin_object);
+    EXPECT_EQ(reader.next(), JSONEvent::key);
+    reader.skip_value();
+    EXPECT_EQ(reader.next(), JSONEvent::key);
+    EXPECT_EQ(reader.string_value(), "f");
+    reader.skip_value();
+    EXPECT_EQ(reader.next(), JSONEvent::key);
+    EXPECT_EQ(reader.string_value(), "g");
+    reader.skip_value();
+    EXPECT_THROW(reader.skip_value(), JSONParseError);
+}
+
+/// Token positions computed byte by byte, the reference for the structural index. Like the index, it lets backslashes
+/// escape the next character outside of strings as well (which is invalid JSON anyway).
+std::vector<uint32_t>
+reference_token_positions(std::string_view json)
+{
+    std::vector<uint32_t> positions;
+    bool                  in_string   = false;
+    bool                  escaped     = false;
+    bool                  prev_scalar = false;
+    for (size_t i = 0; i < json.size(); ++i)
+    {
+        char c          = json[i];
+        bool is_escaped = escaped;
+        bool is_quote   = c == '"' && !is_escaped;
+        escaped         = !is_escaped && c == '\\';
+        if (in_string)
+        {
+            in_string   = !is_quote;
+            prev_scalar = false;
+            continue;
+        }
+        bool is_op  = std::string_view("{}[]:,").find(c) != std::string_view::npos;
+        bool scalar = !is_op && std::string_view(" \t\n\r\"").find(c) == std::string_view::npos;
+        if (is_op || is_quote || (scalar && !prev_scalar))
+        {
+            positions.push_back(static_cast<uint32_t>(i));
+        }
+        in_string   = is_quote;
+        prev_scalar = scalar;
+    }
+    return positions;
+}
+
+TEST(JSONReaderTests, StructuralIndexHasThePositionsOfAllTokens)
+{
+    std::string_view json = R"({ "a\"b" : [ 12, true,"x"], "c":-1.5e3 })";
+    StructuralIndex  index{json};
+    EXPECT_EQ(std::vector<uint32_t>(index.begin(), index.end()),
+              (std::vector<uint32_t>{0, 2, 9, 11, 13, 15, 17, 21, 22, 25, 26, 28, 31, 32, 39}));
+}
+
+TEST(JSONReaderTests, AllStructuralIndexImplementationsAgree)
+{
+    std::vector<json_index::classify_fn> implementations{json_index::classify_scalar};
+#ifdef BOQ_JSON_INDEX_X86
+    implementations.push_back(json_index::classify_sse2);
+    if (__builtin_cpu_supports("avx2"))
+    {
+        implementations.push_back(json_index::classify_avx2);
+    }
+#endif
+
+    // random inputs made of the characters the index distinguishes, with long runs of backslashes and strings crossing
+    // the 64 byte blocks
+    std::mt19937                       rng{42};
+    const std::string_view             alphabet = "{}[]:, \t\n\"\\\\\\\\aa1";
+    std::uniform_int_distribution<int> length_distribution{0, 300};
+    std::uniform_int_distribution<int> char_distribution{0, static_cast<int>(alphabet.size()) - 1};
+    for (int n = 0; n < 2000; ++n)
+    {
+        std::string json(static_cast<size_t>(length_distribution(rng)), ' ');
+        for (char &c : json)
+        {
+            c = alphabet[static_cast<size_t>(char_distribution(rng))];
+        }
+        std::vector<uint32_t> expected = reference_token_positions(json);
+        for (auto classify : implementations)
+        {
+            StructuralIndex index{json, classify};
+            ASSERT_EQ(std::vector<uint32_t>(index.begin(), index.end()), expected) << json;
+        }
+    }
+}
+
+TEST(JSONReaderTests, ReadsWithStructuralIndex)
+{
+    BufferSink sink;
+    {
+        basic_json_writer writer{sink};
+        for (int i = 0; i < 20; ++i)
+        {
+            // long enough to cross several 64 byte blocks, with escapes at different positions
+            writer << NVP{"person" + std::to_string(i),
+                          Person{std::string(static_cast<size_t>(i) * 7, '\\') + "\"x\"", Address{"street", i}}};
+        }
+        writer << NVP{"values", std::vector<double>{1.5, -2e-10, 0}};
+    }
+    EXPECT_EQ(read_events(sink.view(), true), read_events(sink.view()));
+
+    std::string_view pretty = "{\n    \"a\" : [\n        true,\n        null\n    ],\n    \"b\" : \"\\u0041\"\n}\n";
+    EXPECT_EQ(read_events(pretty, true), "{ key:a [ true null ] key:b string:A } ");
+}
+
+#ifdef BOQ_HAS_MAPPED_FILE
+TEST(JSONReaderTests, ReadsFromMappedFile)
+{
+    char path[] = "/tmp/boq_json_reader_XXXXXX";
+    int  fd     = mkstemp(path);
+    ASSERT_GE(fd, 0);
+    {
+        FdSink            sink{fd};
+        basic_json_writer writer{sink};
+        writer << NVP{"hello", Person{"Bob", Address{"some_street", 42}}};
+    }
+    close(fd);
+
+    {
+        MappedFile file{path};
+        EXPECT_EQ(read_events(file.view()),
+                  "{ key:hello { key:name string:Bob key:address { key:street_name string:some_street key:house_number "
+                  "number:42 } } } ");
+    }
+    std::remove(path);
+    EXPECT_THROW(MappedFile{path}, std::system_error);
+}
+#endif
+
+TEST(JSONDeserializeTests, PerfectHashFindsEveryFieldName)
+{
+    static constexpr std::array<std::string_view, 6> names{"name", "address", "street_name", "house_number", "", "x"};
+    static constexpr auto                            table = json_detail::make_perfect_hash(names);
+    static_assert(table.find("name") == 0);
+    static_assert(table.find("address") == 1);
+    static_assert(table.find("street_name") == 2);
+    static_assert(table.find("house_number") == 3);
+    static_assert(table.find("") == 4);
+    static_assert(table.find("x") == 5);
+    static_assert(table.find("y") == names.size());
+    static_assert(table.find("names") == names.size());
+}
+
+TEST(JSONDeserializeTests, WriterOutputIsDeserializedIntoReflectedTypes)
+{
+    std::vector<ReflectedPerson> people{ReflectedPerson{"Bob", ReflectedAddress{"some_street", 42}},
+                                        ReflectedPerson{"A \"quoted\" name", ReflectedAddress{"x", -1}}};
+    BufferSink                   sink;
+    {
+        basic_json_writer writer{sink};
+        writer << nvp<"people">(people);
+    }
+
+    JSONReader reader{sink.view()};
+    EXPECT_EQ(reader.next(), JSONEvent::begin_object);
+    EXPECT_EQ(reader.next(), JSONEvent::key);
+    std::vector<ReflectedPerson> result;
+    deserialize(reader, result);
+    EXPECT_EQ(result, people);
+}
+
+TEST(JSONDeserializeTests, KeysInAnyOrderAndUnknownKeysAreHandled)
+{
+    JSONReader reader{R"({ "address" : { "house_number" : 7, "zip" : [ 1, { "a" : null } ] }, "age" : 3,
+                           "name" : "Bob" })"};
+    ReflectedPerson person{"", ReflectedAddress{"unchanged", 0}};
+    deserialize(reader, person);
+    EXPECT_EQ(person, (ReflectedPerson{"Bob", ReflectedAddress{"unchanged", 7}}));
+}
+
+TEST(JSONDeserializeTests, BuiltinTypesAreDeserialized)
+{
+    JSONReader          reader{R"([ true, -12, 2.5, "text", [ 1, 2, 3 ], 18446744073709551615 ])"};
+    bool                b = false;
+    int                 i = 0;
+    double              d = 0;
+    std::string         s;
+    std::vector<int>    list{9};
+    unsigned long long  big = 0;
+    reader.next();
+    deserialize(reader, b);
+    deserialize(reader, i);
+    deserialize(reader, d);
+    deserialize(reader, s);
+    deserialize(reader, list);
+    deserialize(reader, big);
+    EXPECT_TRUE(b);
+    EXPECT_EQ(i, -12);
+    EXPECT_EQ(d, 2.5);
+    EXPECT_EQ(s, "text");
+    EXPECT_EQ(list, (std::vector<int>{1, 2, 3}));
+    EXPECT_EQ(big, std::numeric_limits<unsigned long long>::max());
+}
+
+TEST(JSONDeserializeTests, MismatchingInputThrows)
+{
+    auto read_int = [](std::string_view json) {
+        JSONReader reader{json};
+        int        i = 0;
+        deserialize(reader, i);
+    };
+    EXPECT_THROW(read_int("\"1\""), JSONParseError);
+    EXPECT_THROW(read_int("1.5"), JSONParseError);
+    EXPECT_THROW(read_int("1e3"), JSONParseError);
+    EXPECT_THROW(read_int("3000000000"), JSONParseError);
+
+    JSONReader      reader{R"({ "name" : 5 })"};
+    ReflectedPerson person;
+    EXPECT_THROW(deserialize(reader, person), JSONParseError);
+}
+
+TEST(LazyDocumentTests, ArenaAllocationsAreAlignedAndLargeOnesGetTheirOwnBlock)
+{
+    Arena arena{256};
+    char *c = arena.allocate_array<char>(3);
+    auto *d = arena.allocate_array<double>(4);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(d) % alignof(double), 0u);
+    EXPECT_GE(reinterpret_cast<char *>(d), c + 3);
+    EXPECT_EQ(arena.block_count(), 1u);
+    arena.allocate_array<char>(1000);
+    EXPECT_EQ(arena.block_count(), 2u);
+    arena.allocate_array<char>(250);
+    EXPECT_EQ(arena.block_count(), 3u);
+    arena.reset();
+    EXPECT_EQ(arena.block_count(), 1u);
+    EXPECT_EQ(arena.allocate_array<char>(1), c);
+}
+
+TEST(LazyDocumentTests, FieldsAreAccessedByKey)
+{
+    std::string  json = R"({ "name" : "Bob", "age" : 42, "address" : { "street_name" : "some_street",
+                             "house_number" : 7 }, "scores" : [ 1.5, 2, [ 3 ] ], "admin" : false, "boss" : null })";
+    LazyDocument doc{json};
+    LazyValue    root = doc.root();
+    EXPECT_EQ(root.type(), JSONType::object);
+    EXPECT_EQ(root["name"].as_string(), "Bob");
+    EXPECT_EQ(root["name"].as_string().data(), json.data() + json.find("Bob"));
+    EXPECT_EQ(root["age"].get<int>(), 42);
+    EXPECT_EQ(root["address"]["house_number"].get<int>(), 7);
+    EXPECT_EQ(root["address"]["street_name"].get<std::string>(), "some_street");
+    EXPECT_FALSE(root["admin"].get<bool>());
+    EXPECT_TRUE(root["boss"].is_null());
+    EXPECT_FALSE(root["age"].is_null());
+    EXPECT_EQ(root["scores"].type(), JSONType::array);
+    EXPECT_FALSE(root.find_field("missing").has_value());
+    EXPECT_THROW(root["missing"], std::out_of_range);
+    EXPECT_EQ(doc.arena().block_count(), 0u);
+}
+
+TEST(LazyDocumentTests, ObjectsAndArraysAreMaterializedInTheArena)
+{
+    LazyDocument doc{R"({ "scores" : [ 1.5, { "a" : [] }, [ 3 ], "x" ], "empty" : {}, "none" : [] })"};
+    LazyObject   object = doc.root().as_object();
+    ASSERT_EQ(object.size(), 3u);
+    EXPECT_EQ(object.key(0), "scores");
+    EXPECT_EQ(object.key(2), "none");
+    EXPECT_EQ(object["empty"].as_object().size(), 0u);
+    EXPECT_EQ(object.value(2).as_array().size(), 0u);
+
+    LazyArray scores = object["scores"].as_array();
+    ASSERT_EQ(scores.size(), 4u);
+    EXPECT_EQ(scores[0].get<double>(), 1.5);
+    EXPECT_EQ(scores[1]["a"].type(), JSONType::array);
+    EXPECT_EQ(scores[2].get<std::vector<int>>(), std::vector<int>{3});
+    EXPECT_EQ(scores[3].as_string(), "x");
+    EXPECT_THROW(scores[4], std::out_of_range);
+    EXPECT_EQ(doc.arena().block_count(), 1u);
+}
+
+TEST(LazyDocumentTests, EscapedKeysAndStringsAreDecoded)
+{
+    LazyDocument doc{R"({ "a\"b" : "line\nbreak", "\u00e9" : 1 })"};
+    LazyValue    root = doc.root();
+    EXPECT_EQ(root["a\"b"].as_string(), "line\nbreak");
+    EXPECT_EQ(root["\xc3\xa9"].get<int>(), 1);
+    LazyObject object = root.as_object();
+    EXPECT_EQ(object.key(0), "a\"b");
+    EXPECT_EQ(object.key(1), "\xc3\xa9");
+}
+
+TEST(LazyDocumentTests, ReflectedTypesAreReadFromValues)
+{
+    LazyDocument doc{R"({ "id" : 1, "person" : { "name" : "Bob", "address" : { "street_name" : "some_street",
+                          "house_number" : 42 } } })"};
+    EXPECT_EQ(doc.root()["person"].get<ReflectedPerson>(),
+              (ReflectedPerson{"Bob", ReflectedAddress{"some_street", 42}}));
+}
+
+TEST(LazyDocumentTests, OnlyAccessedValuesAreValidated)
+{
+    LazyDocument doc{R"({ "bad" : [ tru, 1x, "\q" ], "good" : 5, "text" : 1e })"};
+    EXPECT_EQ(doc.root()["good"].get<int>(), 5);
+    EXPECT_THROW(doc.root()["bad"].get<std::vector<int>>(), JSONParseError);
+    EXPECT_THROW(doc.root()["text"].get<double>(), JSONParseError);
+    EXPECT_THROW(doc.root()["good"].as_string(), JSONParseError);
+    EXPECT_THROW(doc.root()["good"]["x"], JSONParseError);
+    EXPECT_THROW(doc.root()["good"].as_array(), JSONParseError);
+
+    LazyDocument unbalanced{"{ \"a\" : [ 1 }"};
+    EXPECT_THROW(unbalanced.root()["a"].as_array(), JSONParseError);
+    EXPECT_THROW(unbalanced.root()["b"], JSONParseError);
+    EXPECT_THROW(LazyDocument{"[ 1 ] 2"}, JSONParseError);
+    EXPECT_THROW(LazyDocument{"  "}, JSONParseError);
+    LazyDocument missing_colon{R"({ "a" 1 })"};
+    EXPECT_THROW(missing_colon.root()["a"], JSONParseError);
+}
+
+TEST(LazyDocumentTests, LoadReplacesTheDocument)
+{
+    LazyDocument doc{R"({ "values" : [ 1, 2 ] })"};
+    EXPECT_EQ(doc.root()["values"].as_array().size(), 2u);
+    doc.load("[ 7 ]");
+    EXPECT_EQ(doc.root().as_array()[0].get<int>(), 7);
+    EXPECT_THROW(doc.load("7 8"), JSONParseError);
+}
+
+TEST(JSONNumberTests, EightDigitChunksAreDetectedAndParsed)
+{
+    EXPECT_TRUE(json_number::is_eight_digits("12345678"));
+    EXPECT_TRUE(json_number::is_eight_digits("00000000"));
+    EXPECT_FALSE(json_number::is_eight_digits("1234567a"));
+    EXPECT_FALSE(json_number::is_eight_digits("/2345678")); // the characters next to the digits
+    EXPECT_FALSE(json_number::is_eight_digits("1234:678"));
+    EXPECT_FALSE(json_number::is_eight_digits("1234.678"));
+    EXPECT_EQ(json_number::parse_eight_digits("12345678"), 12345678u);
+    EXPECT_EQ(json_number::parse_eight_digits("00000000"), 0u);
+    EXPECT_EQ(json_number::parse_eight_digits("99999999"), 99999999u);
+    EXPECT_EQ(json_number::parse_eight_digits("00700001"), 700001u);
+}
+
+TEST(JSONNumberTests, ParsingAgreesWithFromChars)
+{
+    std::mt19937_64 rng{42};
+    auto            digits = [&](size_t n, bool leading_zero) {
+        std::string result;
+        for (size_t i = 0; i < n; ++i)
+        {
+            result += static_cast<char>('0' + (i == 0 && !leading_zero ? 1 + rng() % 9 : rng() % 10));
+        }
+        return result;
+    };
+    auto check = [](const std::string &text) {
+        auto check_type = [&]<typename T>(T) {
+            T    expected{};
+            T    actual{};
+            auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), expected);
+            bool expected_ok  = error == std::errc{} && end == text.data() + text.size();
+            if (std::is_floating_point_v<T> && error == std::errc::result_out_of_range)
+            {
+                // older standard libraries reject subnormal results, which parse converts
+                return;
+            }
+            ASSERT_EQ(json_number::parse(text, actual), expected_ok) << text;
+            if (expected_ok)
+            {
+                if constexpr (std::is_floating_point_v<T>)
+                {
+                    ASSERT_EQ(std::bit_cast<uint64_t>(actual), std::bit_cast<uint64_t>(expected)) << text;
+                }
+                else
+                {
+                    ASSERT_EQ(actual, expected) << text;
+                }
+            }
+        };
+        check_type(int{});
+        check_type(int64_t{});
+        check_type(uint64_t{});
+        check_type(double{});
+    };
+
+    for (size_t i = 0; i < 100'000; ++i)
+    {
+        size_t      n_digits = 1 + rng() % 25;
+        std::string text     = rng() % 2 == 0 ? "-" : "";
+        text += n_digits == 1 ? digits(1, true) : digits(n_digits, false);
+        if (rng() % 2 == 0)
+        {
+            text += "." + digits(1 + rng() % 20, true);
+        }
+        if (rng() % 3 == 0)
+        {
+            text += (rng() % 2 == 0 ? "e" : "E-") + digits(1 + rng() % 3, true);
+        }
+        check(text);
+    }
+    for (const char *text : {"0", "-0", "9223372036854775807", "-9223372036854775808", "9223372036854775808",
+                             "18446744073709551615", "18446744073709551616", "2147483648", "-2147483649",
+                             "9007199254740993", "1e22", "1e23", "4.9e-324", "1.7976931348623157e308", "1e400",
+                             "00000000000000000000001"})
+    {
+        check(text);
+    }
+
+    // numbers too small for a double are valid JSON and round to zero with their sign, numbers too large are rejected
+    std::string long_underflow = "0." + std::string(400, '0') + "1e-100";
+    std::string many_digits    = "1" + std::string(1000, '7') + "e-1400";
+    for (const std::string &text : {std::string{"1e-400"}, std::string{"-1e-400"}, std::string{"2.4703282292062327e-324"},
+                                     std::string{"1e-99999999999999999999"}, long_underflow, many_digits})
+    {
+        double underflow = 1;
+        ASSERT_TRUE(json_number::parse(text, underflow)) << text;
+        EXPECT_EQ(std::bit_cast<uint64_t>(underflow), std::bit_cast<uint64_t>(text[0] == '-' ? -0.0 : 0.0)) << text;
+    }
+    // many significant digits are cut off without changing the rounding of a subnormal result
+    std::string subnormal = "2.4703282292062328" + std::string(900, '0') + "1e-324";
+    double      min_subnormal{};
+    ASSERT_TRUE(json_number::parse(subnormal, min_subnormal));
+    EXPECT_EQ(min_subnormal, std::numeric_limits<double>::denorm_min());
+
+    double d = 0;
+    for (const char *text : {"1e400", "-1e400", "1e99999999999999999999"})
+    {
+        EXPECT_FALSE(json_number::parse(text, d)) << text;
+    }
+    for (const char *text : {"", "-", "+1", "1.", ".5", "1e", "1e+", "inf", "nan", "-inf", "1x", "0x10"})
+    {
+        EXPECT_FALSE(json_number::parse(text, d)) << text;
+    }
+}
+
+TEST(JSONNumberTests, NumbersWrittenByTheWriterAreReadBackExactly)
+{
+    std::mt19937_64      rng{7};
+    std::vector<int>     ints{0, -1, std::numeric_limits<int>::min(), std::numeric_limits<int>::max()};
+    std::vector<int64_t> int64s{std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()};
+    std::vector<double>  doubles{0.0,
+                                 -0.0,
+                                 0.1,
+                                 std::numeric_limits<double>::min(),
+                                 std::numeric_limits<double>::max(),
+                                 std::numeric_limits<double>::denorm_min(),
+                                 -std::numeric_limits<double>::lowest()};
+    for (size_t i = 0; i < 100'000; ++i)
+    {
+        ints.push_back(static_cast<int>(rng()));
+        int64s.push_back(static_cast<int64_t>(rng() >> (rng() % 64)) * (rng() % 2 == 0 ? 1 : -1));
+        double d = std::bit_cast<double>(rng());
+        if (std::isfinite(d))
+        {
+            doubles.push_back(d);
+        }
+        doubles.push_back(static_cast<double>(rng() % 1'000'000) / 1000.0);
+    }
+
+    BufferSink sink;
+    {
+        basic_json_writer writer{sink};
+        writer << NVP{"ints", ints} << NVP{"int64s", int64s} << NVP{"doubles", doubles};
+    }
+    std::vector<int>     ints_read;
+    std::vector<int64_t> int64s_read;
+    std::vector<double>  doubles_read;
+    LazyDocument         doc{sink.view()};
+    ints_read    = doc.root()["ints"].get<std::vector<int>>();
+    int64s_read  = doc.root()["int64s"].get<std::vector<int64_t>>();
+    doubles_read = doc.root()["doubles"].get<std::vector<double>>();
+    EXPECT_EQ(ints_read, ints);
+    EXPECT_EQ(int64s_read, int64s);
+    ASSERT_EQ(doubles_read.size(), doubles.size());
+    for (size_t i = 0; i < doubles.size(); ++i)
+    {
+        ASSERT_EQ(std::bit_cast<uint64_t>(doubles_read[i]), std::bit_cast<uint64_t>(doubles[i])) << doubles[i];
+    }
+}
@@ -0,0 +1,191 @@
+#ifndef BOQ_ALLOCATION_TRACKER_H
+#define BOQ_ALLOCATION_TRACKER_H
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <ostream>
+
+namespace bits_of_q
+{
+    struct AllocStats
+    {
+        size_t n_allocations                           = 0;
+        size_t n_deallocations                         = 0;
+        size_t n_bytes                                 = 0;
+        size_t peak_live_bytes                         = 0;
+        bool   operator==(const AllocStats &other) const = default;
+    };
+
+    inline std::ostream &
+    operator<<(std::ostream &os, const AllocStats &stats)
+    {
+        os << "{ allocations: " << stats.n_allocations << ", deallocations: " << stats.n_deallocations
+           << ", bytes: " << stats.n_bytes << ", peak_live_bytes: " << stats.peak_live_bytes << " }";
+        return os;
+    }
+
+    // Keeps track of the heap allocations done through the global operator new/delete (replaced at the bottom of this
+    // file). The statistics are relative to the last call to reset(): the number of allocations and deallocations, the
+    // total number of bytes allocated and the peak number of bytes that were allocated but not yet deallocated.
+    // Not thread-safe, just like the rest of this testing framework.
+    class AllocationTracker
+    {
+      public:
+        static AllocStats
+        stats()
+        {
+            AllocStats s      = m_stats;
+            s.peak_live_bytes = m_peak_live_bytes - m_live_bytes_at_reset;
+            return s;
+        }
+
+        static AllocStats
+        reset()
+        {
+            AllocStats old_stats  = stats();
+            m_stats               = AllocStats{};
+            m_live_bytes_at_reset = m_live_bytes;
+            m_peak_live_bytes     = m_live_bytes;
+            return old_stats;
+        }
+
+        static void
+        on_allocate(size_t size)
+        {
+            m_stats.n_allocations++;
+            m_stats.n_bytes += size;
+            m_live_bytes += size;
+            if (m_live_bytes > m_peak_live_bytes)
+            {
+                m_peak_live_bytes = m_live_bytes;
+            }
+        }
+
+        static void
+        on_deallocate(size_t size)
+        {
+            m_stats.n_deallocations++;
+            m_live_bytes -= size;
+        }
+
+      private:
+        inline static AllocStats m_stats;
+        inline static size_t     m_live_bytes          = 0;
+        inline static size_t     m_live_bytes_at_reset = 0;
+        inline static size_t     m_peak_live_bytes     = 0;
+    };
+
+    namespace detail
+    {
+        // Every tracked allocation is preceded by a header storing the requested size and the size of the header
+        // itself, so the deallocation functions know how much memory is returned and where the block starts.
+        inline void *
+        tracked_allocate(size_t size, size_t alignment)
+        {
+            constexpr size_t max_align   = alignof(std::max_align_t);
+            size_t           header_size = alignment < 2 * sizeof(size_t) ? 2 * sizeof(size_t) : alignment;
+            header_size                  = (header_size + max_align - 1) / max_align * max_align;
+
+            void *block = nullptr;
+            if (alignment <= max_align)
+            {
+                block = std::malloc(header_size + size);
+            }
+            else
+            {
+                block = std::aligned_alloc(alignment, (header_size + size + alignment - 1) / alignment * alignment);
+            }
+            if (block == nullptr)
+            {
+                throw std::bad_alloc{};
+            }
+            auto *ptr                           = static_cast<std::byte *>(block) + header_size;
+            reinterpret_cast<size_t *>(ptr)[-1] = size;
+            reinterpret_cast<size_t *>(ptr)[-2] = header_size;
+            AllocationTracker::on_allocate(size);
+            return ptr;
+        }
+
+        inline void
+        tracked_deallocate(void *ptr) noexcept
+        {
+            if (ptr == nullptr)
+            {
+                return;
+            }
+            size_t size        = static_cast<size_t *>(ptr)[-1];
+            size_t header_size = static_cast<size_t *>(ptr)[-2];
+            AllocationTracker::on_deallocate(size);
+            std::free(static_cast<std::byte *>(ptr) - header_size);
+        }
+    } // namespace detail
+} // namespace bits_of_q
+
+// Replacements of the global allocation functions, forwarding every allocation to the AllocationTracker.
+// As these can only be defined once per program, this header (and TestUtilities.h, which includes it) can only be
+// included in a single translation unit (unless BOQ_NO_ALLOCATION_TRACKING is defined in all others).
+#ifndef BOQ_NO_ALLOCATION_TRACKING
+void *
+operator new(size_t size)
+{
+    return ::bits_of_q::detail::tracked_allocate(size, alignof(std::max_align_t));
+}
+void *
+operator new[](size_t size)
+{
+    return ::bits_of_q::detail::tracked_allocate(size, alignof(std::max_align_t));
+}
+void *
+operator new(size_t size, std::align_val_t alignment)
+{
+    return ::bits_of_q::detail::tracked_allocate(size, static_cast<size_t>(alignment));
+}
+void *
+operator new[](size_t size, std::align_val_t alignment)
+{
+    return ::bits_of_q::detail::tracked_allocate(size, static_cast<size_t>(alignment));
+}
+void
+operator delete(void *ptr) noexcept
+{
+    ::bits_of_q::detail::tracked_deallocate(ptr);
+}
+void
+operator delete[](void *ptr) noexcept
+{
+    ::bits_of_q::detail::tracked_deallocate(ptr);
+}
+void
+operator delete(void *ptr, size_t) noexcept
+{
+    ::bits_of_q::detail::tracked_deallocate(ptr);
+}
+void
+operator delete[](void *ptr, size_t) noexcept
+{
+    ::bits_of_q::detail::tracked_deallocate(ptr);
+}
+void
+operator delete(void *ptr, std::align_val_t) noexcept
+{
+    ::bits_of_q::detail::tracked_deallocate(ptr);
+}
+void
+operator delete[](void *ptr, std::align_val_t) noexcept
+{
+    ::bits_of_q::detail::tracked_deallocate(ptr);
+}
+void
+operator delete(void *ptr, size_t, std::align_val_t) noexcept
+{
+    ::bits_of_q::detail::tracked_deallocate(ptr);
+}
+void
+operator delete[](void *ptr, size_t, std::align_val_t) noexcept
+{
+    ::bits_of_q::detail::tracked_deallocate(ptr);
+}
+#endif // BOQ_NO_ALLOCATION_TRACKING
+
+#endif // BOQ_ALLOCATION_TRACKER_H
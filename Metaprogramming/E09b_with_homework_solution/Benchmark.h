@@ -0,0 +1,177 @@
+#ifndef BOQ_BENCHMARK_H
+#define BOQ_BENCHMARK_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <string_view>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/// This namespace contains a small runtime benchmarking framework, in the same spirit as the testing framework in
+/// TestUtilities.h. For any serious measurements, please use a well-established library such as Google Benchmark.
+namespace bits_of_q::benchmark
+{
+    // Prevents the compiler from optimizing away the computation of value, without adding any instructions.
+    template <typename T>
+    inline void
+    do_not_optimize(T &&value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static_cast<void>(value);
+#endif
+    }
+
+    // Prevents the compiler from assuming anything about memory contents across this point.
+    inline void
+    clobber_memory()
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : : "memory");
+#endif
+    }
+
+    // Counts the instructions retired by the calling thread using the perf_event_open interface. On platforms without
+    // perf events, or when the kernel does not allow access to them (see /proc/sys/kernel/perf_event_paranoid), the
+    // counter is simply unavailable and read() returns an empty optional.
+    class InstructionCounter
+    {
+      public:
+        InstructionCounter()
+        {
+#if defined(__linux__)
+            perf_event_attr attr{};
+            attr.type           = PERF_TYPE_HARDWARE;
+            attr.size           = sizeof(attr);
+            attr.config         = PERF_COUNT_HW_INSTRUCTIONS;
+            attr.disabled       = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv     = 1;
+            m_fd                = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+        }
+        InstructionCounter(const InstructionCounter &)            = delete;
+        InstructionCounter &operator=(const InstructionCounter &) = delete;
+        ~InstructionCounter()
+        {
+#if defined(__linux__)
+            if (m_fd >= 0)
+            {
+                close(m_fd);
+            }
+#endif
+        }
+
+        bool
+        available() const
+        {
+            return m_fd >= 0;
+        }
+
+        void
+        start()
+        {
+#if defined(__linux__)
+            if (available())
+            {
+                ioctl(m_fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(m_fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+#endif
+        }
+
+        std::optional<uint64_t>
+        stop()
+        {
+#if defined(__linux__)
+            if (available())
+            {
+                ioctl(m_fd, PERF_EVENT_IOC_DISABLE, 0);
+                uint64_t count = 0;
+                if (::read(m_fd, &count, sizeof(count)) == sizeof(count))
+                {
+                    return count;
+                }
+            }
+#endif
+            return std::nullopt;
+        }
+
+      private:
+        int m_fd = -1;
+    };
+
+    struct Result
+    {
+        double                ns_per_op;
+        std::optional<double> instructions_per_op;
+    };
+
+    class Benchmark
+    {
+      public:
+        // Executes the function n_iterations times (after a short warmup) and prints the time and number of retired
+        // instructions per call. The function should pass its result to do_not_optimize so the work isn't elided.
+        template <typename FUNC>
+        static Result
+        run(std::string_view name, uint64_t n_iterations, FUNC &&function)
+        {
+            for (uint64_t i = 0; i < n_iterations / 10 + 1; ++i)
+            {
+                function();
+            }
+
+            static InstructionCounter counter;
+            counter.start();
+            auto start = std::chrono::steady_clock::now();
+            for (uint64_t i = 0; i < n_iterations; ++i)
+            {
+                function();
+                clobber_memory();
+            }
+            auto end          = std::chrono::steady_clock::now();
+            auto instructions = counter.stop();
+
+            auto   ns = std::chrono::duration<double, std::nano>(end - start).count();
+            Result result{ns / static_cast<double>(n_iterations), std::nullopt};
+            if (instructions)
+            {
+                result.instructions_per_op = static_cast<double>(*instructions) / static_cast<double>(n_iterations);
+            }
+            print(name, result);
+            return result;
+        }
+
+        static void
+        print_header()
+        {
+            std::printf("%-40s %12s %12s\n", "benchmark", "ns/op", "instr/op");
+        }
+
+      private:
+        static void
+        print(std::string_view name, const Result &result)
+        {
+            if (result.instructions_per_op)
+            {
+                std::printf("%-40.*s %12.3f %12.1f\n", static_cast<int>(name.size()), name.data(), result.ns_per_op,
+                            *result.instructions_per_op);
+            }
+            else
+            {
+                std::printf("%-40.*s %12.3f %12s\n", static_cast<int>(name.size()), name.data(), result.ns_per_op,
+                            "n/a");
+            }
+        }
+    };
+} // namespace bits_of_q::benchmark
+
+#endif // BOQ_BENCHMARK_H
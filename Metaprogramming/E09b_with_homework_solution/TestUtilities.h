@@ -10,6 +10,7 @@
 #include <utility>
 #include <vector>
 
+#include "AllocationTracker.h"
 #include "Metaprogramming.h"
 
 namespace bits_of_q
@@ -156,6 +157,16 @@ namespace bits_of_q::testing
             __FILE__, __LINE__, std::string{"ASSERT_EQ("} + #expr1 + ", " + #expr2 + ")", ss1.str(), ss2.str()};       \
     }
 
+// Asserts that at most n heap allocations happened since the start of the test (or the last
+// AllocationTracker::reset())
+#define ASSERT_ALLOCS_LE(n)                                                                                            \
+    if (!(::bits_of_q::AllocationTracker::stats().n_allocations <= (n)))                                              \
+    {                                                                                                                  \
+        std::string allocs = std::to_string(::bits_of_q::AllocationTracker::stats().n_allocations);                   \
+        throw ::bits_of_q::testing::AssertEqFailed{__FILE__, __LINE__, std::string{"ASSERT_ALLOCS_LE("} + #n + ")",   \
+                                                   allocs, std::to_string(n)};                                         \
+    }
+
     inline void
     output_specific_assert_info(const AssertFailed &)
     {
@@ -208,12 +219,13 @@ namespace bits_of_q::testing
 
       public:
         // Executes the function outputting a banner at the start and end as well as printing information on exceptions
-        // thrown by the function.
+        // thrown by the function. The heap allocations done by the function are reported at the end.
         template <typename FUNC>
         static void
         test(std::string_view test_name, FUNC &&function)
         {
             print_test_start(test_name);
+            AllocationTracker::reset();
             try
             {
                 function();
@@ -236,14 +248,17 @@ namespace bits_of_q::testing
         static void
         print_test_end(std::string_view test_name, bool passed)
         {
+            AllocStats allocs = AllocationTracker::stats();
             if (passed)
             {
-                std::cerr << color_green << "[       OK ] " << color_reset << test_name << "\n";
+                std::cerr << color_green << "[       OK ] " << color_reset << test_name;
             }
             else
             {
-                std::cerr << color_red << "[  FAILED  ] " << color_reset << test_name << "\n";
+                std::cerr << color_red << "[  FAILED  ] " << color_reset << test_name;
             }
+            std::cerr << " (allocations: " << allocs.n_allocations << ", bytes: " << allocs.n_bytes
+                      << ", peak live bytes: " << allocs.peak_live_bytes << ")\n";
         }
     };
 
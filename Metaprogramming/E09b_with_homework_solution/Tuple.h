@@ -1,31 +1,203 @@
 #ifndef BOQ_TUPLE_H
 #define BOQ_TUPLE_H
 
+#include <array>
+#include <compare>
+#include <cstdint>
+#include <cstring>
 #include <functional>
 #include <memory>
+#include <stdexcept>
 #include <type_traits>
 #include <utility>
 
 #include "Metaprogramming.h"
 
+#if defined(_MSC_VER)
+#define BOQ_NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#else
+#define BOQ_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#endif
+
 namespace bits_of_q
 {
 
+    template <typename TUPLE>
+    struct tuple_size;
+
+    namespace detail
+    {
+        // Storage for the element at index i of a Tuple. Every element is stored in its own base class, the index makes
+        // sure the bases are unique even if the same type occurs multiple times.
+        // Empty elements (tag types, stateless comparators or allocators, lambdas without captures, ...) take up no
+        // space: their leaf specialization marks the element [[no_unique_address]], so the leaf is an empty base class
+        // itself. Other elements are plain members, [[no_unique_address]] would allow the compiler to place the next
+        // element in their tail padding, where it is overwritten by assignments to (or memcpy of) the element.
+        template <size_t i, typename ELEM, bool is_empty = std::is_empty_v<ELEM>>
+        struct tuple_leaf
+        {
+            using type = ELEM;
+
+            constexpr tuple_leaf() = default;
+            template <typename T>
+            explicit constexpr tuple_leaf(T &&e) : data(std::forward<T>(e))
+            {
+            }
+            // constructs the element in place from the elements of the tuple args
+            template <typename ARGS_TUPLE>
+            constexpr tuple_leaf(std::piecewise_construct_t, ARGS_TUPLE &&args)
+                : tuple_leaf(std::forward<ARGS_TUPLE>(args),
+                             std::make_index_sequence<tuple_size<std::remove_cvref_t<ARGS_TUPLE>>::value>{})
+            {
+            }
+            ELEM data;
+
+          private:
+            template <typename ARGS_TUPLE, size_t... arg_indices>
+            constexpr tuple_leaf([[maybe_unused]] ARGS_TUPLE &&args, std::index_sequence<arg_indices...>)
+                : data(get<arg_indices>(std::forward<ARGS_TUPLE>(args))...)
+            {
+            }
+        };
+
+        template <size_t i, typename ELEM>
+        struct tuple_leaf<i, ELEM, true>
+        {
+            using type = ELEM;
+
+            constexpr tuple_leaf() = default;
+            template <typename T>
+            explicit constexpr tuple_leaf(T &&e) : data(std::forward<T>(e))
+            {
+            }
+            template <typename ARGS_TUPLE>
+            constexpr tuple_leaf(std::piecewise_construct_t, ARGS_TUPLE &&args)
+                : tuple_leaf(std::forward<ARGS_TUPLE>(args),
+                             std::make_index_sequence<tuple_size<std::remove_cvref_t<ARGS_TUPLE>>::value>{})
+            {
+            }
+            BOQ_NO_UNIQUE_ADDRESS ELEM data;
+
+          private:
+            template <typename ARGS_TUPLE, size_t... arg_indices>
+            constexpr tuple_leaf([[maybe_unused]] ARGS_TUPLE &&args, std::index_sequence<arg_indices...>)
+                : data(get<arg_indices>(std::forward<ARGS_TUPLE>(args))...)
+            {
+            }
+        };
+
+        template <typename INDEX_SEQ, typename... ELEMS>
+        struct tuple_storage;
+
+        template <size_t... indices, typename... ELEMS>
+        struct tuple_storage<std::index_sequence<indices...>, ELEMS...> : tuple_leaf<indices, ELEMS>...
+        {
+            constexpr tuple_storage() = default;
+            template <typename... Ts>
+            explicit constexpr tuple_storage(Ts &&...elems) : tuple_leaf<indices, ELEMS>(std::forward<Ts>(elems))...
+            {
+            }
+            template <typename... ARGS_TUPLES>
+            constexpr tuple_storage(std::piecewise_construct_t, ARGS_TUPLES &&...args)
+                : tuple_leaf<indices, ELEMS>(std::piecewise_construct, std::forward<ARGS_TUPLES>(args))...
+            {
+            }
+        };
+    } // namespace detail
+
+    // All elements are stored in a flat list of base classes (one detail::tuple_leaf per element) rather than in a
+    // recursive chain of Tuples. Accessing an element is therefore a single cast to the base class holding it, and a
+    // Tuple with n elements only needs n + 1 instantiations.
+    // All special member functions are defaulted, so a Tuple is trivially copyable, destructible and default
+    // constructible whenever all of its elements are.
     template <typename... ELEMS>
-    struct Tuple
+    struct Tuple : detail::tuple_storage<std::index_sequence_for<ELEMS...>, ELEMS...>
     {
         constexpr Tuple() = default;
-    };
 
-    template <typename ELEM0, typename... ELEMS1toN>
-    struct Tuple<ELEM0, ELEMS1toN...> : Tuple<ELEMS1toN...>
-    {
         template <typename T, typename... Ts>
+            requires(sizeof...(Ts) + 1 == sizeof...(ELEMS))
         explicit constexpr Tuple(T &&e1, Ts &&...rest)
-            : Tuple<ELEMS1toN...>(std::forward<Ts>(rest)...), data(std::forward<T>(e1))
+            : detail::tuple_storage<std::index_sequence_for<ELEMS...>, ELEMS...>(std::forward<T>(e1),
+                                                                                 std::forward<Ts>(rest)...)
+        {
+        }
+
+        // Converts the elements of another Tuple with the same number of elements, e.g. Tuple<long, std::string> from
+        // Tuple<int, const char *>, or Tuple<const int &> from Tuple<int> &. Implicit if all conversions are.
+        template <typename... Us>
+            requires(sizeof...(Us) == sizeof...(ELEMS) && !std::is_same_v<Tuple<Us...>, Tuple> &&
+                     (std::is_constructible_v<ELEMS, Us &> && ...))
+        explicit(!(std::is_convertible_v<Us &, ELEMS> && ...)) constexpr Tuple(Tuple<Us...> &other)
+            : Tuple(convert_tag{}, other, std::index_sequence_for<ELEMS...>{})
+        {
+        }
+        template <typename... Us>
+            requires(sizeof...(Us) == sizeof...(ELEMS) && !std::is_same_v<Tuple<Us...>, Tuple> &&
+                     (std::is_constructible_v<ELEMS, const Us &> && ...))
+        explicit(!(std::is_convertible_v<const Us &, ELEMS> && ...)) constexpr Tuple(const Tuple<Us...> &other)
+            : Tuple(convert_tag{}, other, std::index_sequence_for<ELEMS...>{})
+        {
+        }
+        template <typename... Us>
+            requires(sizeof...(Us) == sizeof...(ELEMS) && !std::is_same_v<Tuple<Us...>, Tuple> &&
+                     (std::is_constructible_v<ELEMS, Us &&> && ...))
+        explicit(!(std::is_convertible_v<Us &&, ELEMS> && ...)) constexpr Tuple(Tuple<Us...> &&other)
+            : Tuple(convert_tag{}, std::move(other), std::index_sequence_for<ELEMS...>{})
+        {
+        }
+
+        // Constructs every element in place, passing it the elements of the corresponding args tuple, e.g.
+        // Tuple<std::string, Widget>{std::piecewise_construct, forward_as_tuple(3, 'c'), forward_as_tuple()}
+        // This works for elements that can't be copied or moved and avoids moving the elements into the tuple.
+        template <typename... ARGS_TUPLES>
+            requires(sizeof...(ARGS_TUPLES) == sizeof...(ELEMS))
+        constexpr Tuple(std::piecewise_construct_t, ARGS_TUPLES &&...args)
+            : detail::tuple_storage<std::index_sequence_for<ELEMS...>, ELEMS...>(std::piecewise_construct,
+                                                                                 std::forward<ARGS_TUPLES>(args)...)
+        {
+        }
+
+        // Destroys the element at index i and constructs a new one in its place from args, returning a reference to it.
+        // If constructing from args may throw, the new element is constructed first and then moved into place, so the
+        // tuple is unchanged when it throws (this requires a nothrow move constructor).
+        // Empty elements can't be replaced: they are potentially-overlapping subobjects, which aren't transparently
+        // replaceable, so the tuple couldn't access the new object.
+        template <size_t i, typename... ARGS>
+        constexpr auto &
+        emplace(ARGS &&...args)
+        {
+            using elem_t = at_t<type_list<ELEMS...>, i>;
+            static_assert(!std::is_reference_v<elem_t>, "emplace can't rebind reference elements");
+            static_assert(!std::is_const_v<elem_t>, "emplace can't replace const elements");
+            static_assert(!std::is_empty_v<elem_t>, "emplace can't replace empty elements");
+            static_assert(std::is_nothrow_constructible_v<elem_t, ARGS...> ||
+                              std::is_nothrow_move_constructible_v<elem_t>,
+                          "emplace requires a nothrow constructor or a nothrow move constructor");
+            auto &elem = get<i>(*this);
+            if constexpr (std::is_nothrow_constructible_v<elem_t, ARGS...>)
+            {
+                std::destroy_at(&elem);
+                return *std::construct_at(&elem, std::forward<ARGS>(args)...);
+            }
+            else
+            {
+                elem_t replacement(std::forward<ARGS>(args)...);
+                std::destroy_at(&elem);
+                return *std::construct_at(&elem, std::move(replacement));
+            }
+        }
+
+      private:
+        struct convert_tag
+        {
+        };
+
+        template <typename TUP, size_t... indices>
+        constexpr Tuple(convert_tag, TUP &&other, std::index_sequence<indices...>)
+            : detail::tuple_storage<std::index_sequence_for<ELEMS...>, ELEMS...>(get<indices>(std::forward<TUP>(other))...)
         {
         }
-        ELEM0 data;
     };
 
     // deduction guide to make template argument deduction for constructors work (C++17)
@@ -45,13 +217,15 @@ namespace bits_of_q
 
     namespace detail
     {
+        // Overload resolution picks the (unique) base class tuple_leaf<i, ELEM> of the tuple, deducing ELEM
+        template <size_t i, typename ELEM, bool is_empty>
+        tuple_leaf<i, ELEM, is_empty> leaf_of(const tuple_leaf<i, ELEM, is_empty> &);
+
         template <size_t i, typename TUPLE>
-        struct get_impl : get_impl<i - 1, pop_front_t<TUPLE>>
-        {
-        };
+        using leaf_t = decltype(leaf_of<i>(std::declval<const TUPLE &>()));
 
-        template <typename TUPLE>
-        struct get_impl<0, TUPLE>
+        template <size_t i, typename TUPLE>
+        struct get_impl
         {
             template <typename T>
             constexpr static decltype(auto)
@@ -59,23 +233,24 @@ namespace bits_of_q
             {
                 constexpr bool is_lvalue = std::is_lvalue_reference_v<T>;
                 constexpr bool is_const  = std::is_const_v<std::remove_reference_t<T>>;
-                using data_t             = front_t<TUPLE>;
+                using leaf               = leaf_t<i, TUPLE>;
+                using data_t             = typename leaf::type;
 
                 if constexpr (is_lvalue && is_const)
                 {
-                    return static_cast<const data_t &>(static_cast<const TUPLE &>(t).data);
+                    return static_cast<const data_t &>(static_cast<const leaf &>(t).data);
                 }
                 if constexpr (is_lvalue && !is_const)
                 {
-                    return static_cast<data_t &>(static_cast<TUPLE &>(t).data);
+                    return static_cast<data_t &>(static_cast<leaf &>(t).data);
                 }
                 if constexpr (!is_lvalue && is_const)
                 {
-                    return static_cast<const data_t &&>(static_cast<const TUPLE &&>(t).data);
+                    return static_cast<const data_t &&>(static_cast<const leaf &&>(t).data);
                 }
                 if constexpr (!is_lvalue && !is_const)
                 {
-                    return static_cast<data_t &&>(static_cast<TUPLE &&>(t).data);
+                    return static_cast<data_t &&>(static_cast<leaf &&>(t).data);
                 }
             }
         };
@@ -142,54 +317,53 @@ namespace bits_of_q
         template <typename... TUPS>
         using tuple_cat_result_t = typename tuple_cat_result<TUPS...>::type;
 
-        template <typename RESULT_TUPLE, typename INDEX_SEQ>
-        struct make_tuple_from_fwd_tuple;
-
-        template <typename RESULT_TUPLE, size_t... indices>
-        struct make_tuple_from_fwd_tuple<RESULT_TUPLE, std::index_sequence<indices...>>
+        // For every element of the concatenated tuple: the index of the input tuple it comes from (outer) and its index
+        // within that tuple (inner).
+        template <size_t... tuple_sizes>
+        struct tuple_cat_indices
         {
-            template <typename FWD_TUPLE>
-            static constexpr auto
-            f(FWD_TUPLE &&fwd)
-            {
-                return RESULT_TUPLE{get<indices>(std::forward<FWD_TUPLE>(fwd))...};
-            }
-        };
+            static constexpr size_t n_elems = (tuple_sizes + ... + 0);
 
-        template <typename FWD_INDEX_SEQ, typename TUPLE_INDEX_SEQ>
-        struct concat_with_fwd_tuple;
-
-        template <size_t... fwd_indices, size_t... indices>
-        struct concat_with_fwd_tuple<std::index_sequence<fwd_indices...>, std::index_sequence<indices...>>
-        {
-            template <typename FWD_TUPLE, typename TUPLE>
-            static constexpr auto
-            f(FWD_TUPLE &&fwd, TUPLE &&t)
-            {
-                return forward_as_tuple(get<fwd_indices>(std::forward<FWD_TUPLE>(fwd))...,
-                                        get<indices>(std::forward<TUPLE>(t))...);
-            }
+            static constexpr auto indices = []() {
+                std::array<size_t, sizeof...(tuple_sizes)> sizes{tuple_sizes...};
+                std::array<size_t, n_elems>                 outer{};
+                std::array<size_t, n_elems>                 inner{};
+                size_t                                      elem = 0;
+                for (size_t tuple = 0; tuple < sizes.size(); ++tuple)
+                {
+                    for (size_t i = 0; i < sizes[tuple]; ++i, ++elem)
+                    {
+                        outer[elem] = tuple;
+                        inner[elem] = i;
+                    }
+                }
+                return std::pair{outer, inner};
+            }();
+            static constexpr auto outer = indices.first;
+            static constexpr auto inner = indices.second;
         };
 
+        // Builds the result with a single pack expansion over all elements of all input tuples, so no intermediate
+        // tuples are created and every element is forwarded exactly once.
         template <typename RESULT_TUPLE>
         struct tuple_cat_impl
         {
-            template <typename FWD_TUPLE, typename TUPLE, typename... TUPLES>
+            template <typename... TUPLES>
             static constexpr auto
-            f(FWD_TUPLE &&fwd, TUPLE &&t, TUPLES &&...ts)
+            f(TUPLES &&...ts)
             {
-                return f(concat_with_fwd_tuple<std::make_index_sequence<tuple_size_v<std::remove_cvref_t<FWD_TUPLE>>>,
-                                               std::make_index_sequence<tuple_size_v<std::remove_cvref_t<TUPLE>>>>::
-                             f(std::forward<FWD_TUPLE>(fwd), std::forward<TUPLE>(t)),
-                         std::forward<TUPLES>(ts)...);
+                using indices_t = tuple_cat_indices<tuple_size_v<std::remove_cvref_t<TUPLES>>...>;
+                return f_impl<indices_t>(std::make_index_sequence<indices_t::n_elems>{},
+                                         forward_as_tuple(std::forward<TUPLES>(ts)...));
             }
 
-            template <typename FWD_TUPLE>
+          private:
+            template <typename INDICES, size_t... elems, typename FWD_TUPLE>
             static constexpr auto
-            f(FWD_TUPLE &&ret)
+            f_impl(std::index_sequence<elems...>, [[maybe_unused]] FWD_TUPLE &&fwd)
             {
-                return make_tuple_from_fwd_tuple<RESULT_TUPLE, std::make_index_sequence<tuple_size_v<FWD_TUPLE>>>::f(
-                    std::forward<FWD_TUPLE>(ret));
+                return RESULT_TUPLE{
+                    get<INDICES::inner[elems]>(get<INDICES::outer[elems]>(std::forward<FWD_TUPLE>(fwd)))...};
             }
         };
 
@@ -285,6 +459,566 @@ namespace bits_of_q
         // example: Tuple<int, unsigned>
     }
 
+    ////////////////////////////////////////////////////////////
+    ///////////////////////  tuple views  //////////////////////
+    ////////////////////////////////////////////////////////////
+
+    // transform and filter build a new tuple right away, copying or moving every element. The views below don't own
+    // any elements: transform_view calls the function when an element is accessed with get and filter_view maps its
+    // indices to those of the matching elements. Views compose, e.g. make_filter_view<PRED>(make_transform_view(t, f)),
+    // and only build a Tuple when calling materialize. Like std::string_view, a view over an lvalue tuple must not
+    // outlive that tuple. Like std::ranges::owning_view, a view over an rvalue tuple moves it into the view, so a view
+    // over a temporary never dangles (nested views are stored by value as well).
+
+    namespace detail
+    {
+        struct tuple_view_tag
+        {
+        };
+
+        template <typename T>
+        static constexpr bool is_tuple_view_v = std::is_base_of_v<tuple_view_tag, std::remove_cvref_t<T>>;
+
+        // how a view stores the tuple it refers to: lvalue tuples by reference, views and rvalue tuples by value
+        template <typename TUP>
+        using view_base_t = std::conditional_t<is_tuple_view_v<TUP> || !std::is_lvalue_reference_v<TUP>,
+                                               std::remove_cvref_t<TUP>, TUP &&>;
+
+        // element type at index i of a tuple or a view
+        template <typename TUP, size_t i, bool is_view = is_tuple_view_v<TUP>>
+        struct element_of : has_type<tuple_element_t<TUP, i>>
+        {
+        };
+
+        template <typename TUP, size_t i>
+        struct element_of<TUP, i, true> : has_type<typename TUP::template element_t<i>>
+        {
+        };
+
+        template <typename TUP, size_t i>
+        using element_of_t = typename element_of<std::remove_cvref_t<TUP>, i>::type;
+
+        // the base of the view, as an rvalue only if the view is an rvalue and owns its base
+        template <typename VIEW>
+        constexpr decltype(auto)
+        forward_base(VIEW &&view)
+        {
+            using base_t = decltype(view.base);
+            if constexpr (std::is_lvalue_reference_v<VIEW>)
+            {
+                auto &base = view.base;
+                return (base);
+            }
+            else if constexpr (std::is_reference_v<base_t>)
+            {
+                return static_cast<base_t &&>(view.base);
+            }
+            else
+            {
+                return std::move(view.base);
+            }
+        }
+
+        // indices of the elements of TUP for which PREDICATE<element type> is true
+        template <template <typename...> class PREDICATE, typename TUP, size_t... indices>
+        constexpr auto
+        filtered_indices(std::index_sequence<indices...>)
+        {
+            constexpr std::array<bool, sizeof...(indices)> matches{PREDICATE<element_of_t<TUP, indices>>::value...};
+            constexpr size_t n_matches = (size_t{0} + ... + static_cast<size_t>(matches[indices]));
+
+            std::array<size_t, n_matches> result{};
+            size_t                        n = 0;
+            for (size_t i = 0; i < matches.size(); ++i)
+            {
+                if (matches[i])
+                {
+                    result[n++] = i;
+                }
+            }
+            return result;
+        }
+    } // namespace detail
+
+    template <typename BASE, typename FUNC>
+    struct transform_view : detail::tuple_view_tag
+    {
+        template <typename TUP>
+        constexpr transform_view(TUP &&tup, FUNC f) : base(std::forward<TUP>(tup)), func(std::move(f))
+        {
+        }
+
+        // the decayed result of the function, like the elements of the Tuple returned by transform
+        template <size_t i>
+        using element_t = std::unwrap_ref_decay_t<
+            std::invoke_result_t<const FUNC &, decltype(bits_of_q::get<i>(std::declval<BASE &>()))>>;
+
+        BASE                       base;
+        BOQ_NO_UNIQUE_ADDRESS FUNC func;
+    };
+
+    template <typename TUP, typename FUNC>
+    transform_view(TUP &&tup, FUNC f) -> transform_view<detail::view_base_t<TUP>, FUNC>;
+
+    template <typename TUP, typename FUNC>
+    constexpr auto
+    make_transform_view(TUP &&tup, FUNC f)
+    {
+        return transform_view{std::forward<TUP>(tup), std::move(f)};
+    }
+
+    template <template <typename...> class PREDICATE, typename BASE>
+    struct filter_view : detail::tuple_view_tag
+    {
+        // selected_indices[i] is the index in base of element i of the view
+        static constexpr auto selected_indices = detail::filtered_indices<PREDICATE, std::remove_cvref_t<BASE>>(
+            std::make_index_sequence<tuple_size<std::remove_cvref_t<BASE>>::value>{});
+
+        template <typename TUP>
+        explicit constexpr filter_view(TUP &&tup) : base(std::forward<TUP>(tup))
+        {
+        }
+
+        template <size_t i>
+        using element_t = detail::element_of_t<BASE, selected_indices[i]>;
+
+        BASE base;
+    };
+
+    template <template <typename...> class PREDICATE, typename TUP>
+    constexpr auto
+    make_filter_view(TUP &&tup)
+    {
+        return filter_view<PREDICATE, detail::view_base_t<TUP>>{std::forward<TUP>(tup)};
+    }
+
+    template <typename BASE, typename FUNC>
+    struct tuple_size<transform_view<BASE, FUNC>> : tuple_size<std::remove_cvref_t<BASE>>
+    {
+    };
+
+    template <template <typename...> class PREDICATE, typename BASE>
+    struct tuple_size<filter_view<PREDICATE, BASE>>
+        : std::integral_constant<size_t, filter_view<PREDICATE, BASE>::selected_indices.size()>
+    {
+    };
+
+    namespace detail
+    {
+        template <size_t i, typename BASE, typename FUNC>
+        struct get_impl<i, transform_view<BASE, FUNC>>
+        {
+            template <typename T>
+            constexpr static decltype(auto)
+            get(T &&view)
+            {
+                return std::invoke(view.func, bits_of_q::get<i>(forward_base(std::forward<T>(view))));
+            }
+        };
+
+        template <size_t i, template <typename...> class PREDICATE, typename BASE>
+        struct get_impl<i, filter_view<PREDICATE, BASE>>
+        {
+            template <typename T>
+            constexpr static decltype(auto)
+            get(T &&view)
+            {
+                constexpr size_t base_index = filter_view<PREDICATE, BASE>::selected_indices[i];
+                return bits_of_q::get<base_index>(forward_base(std::forward<T>(view)));
+            }
+        };
+
+        template <typename VIEW, size_t... indices>
+        constexpr auto
+        materialize_impl(VIEW &&view, std::index_sequence<indices...>)
+        {
+            return Tuple<element_of_t<VIEW, indices>...>{get<indices>(std::forward<VIEW>(view))...};
+        }
+    } // namespace detail
+
+    // builds a Tuple from the elements of a view, this is where a pipeline of views copies or moves the elements
+    template <typename VIEW>
+    constexpr auto
+    materialize(VIEW &&view)
+    {
+        return detail::materialize_impl(std::forward<VIEW>(view),
+                                        std::make_index_sequence<tuple_size_v<std::remove_cvref_t<VIEW>>>{});
+    }
+
+    ////////////////////////////////////////////////////////////
+    /////////////////////////  apply  //////////////////////////
+    ////////////////////////////////////////////////////////////
+
+    namespace detail
+    {
+        template <typename FUNC, typename TUP, size_t... indices>
+        constexpr decltype(auto)
+        apply_impl(FUNC &&f, TUP &&tup, std::index_sequence<indices...>)
+        {
+            return std::forward<FUNC>(f)(get<indices>(std::forward<TUP>(tup))...);
+        }
+    } // namespace detail
+
+    template <typename FUNC, typename TUP>
+    constexpr decltype(auto)
+    apply(FUNC &&f, TUP &&tup)
+    {
+        return detail::apply_impl(std::forward<FUNC>(f), std::forward<TUP>(tup),
+                                  std::make_index_sequence<tuple_size_v<std::remove_cvref_t<TUP>>>{});
+    }
+
+    ////////////////////////////////////////////////////////////
+    ////////////////////////  visit_at  ////////////////////////
+    ////////////////////////////////////////////////////////////
+
+    namespace detail
+    {
+        template <typename TUP, typename FUNC, typename INDEX_SEQ>
+        struct visit_at_table;
+
+        // Table with one function pointer per element, calling the function with the element at that index. This makes
+        // the dispatch on a runtime index a single indirect call, independent of the number of elements.
+        template <typename TUP, typename FUNC, size_t... indices>
+        struct visit_at_table<TUP, FUNC, std::index_sequence<indices...>>
+        {
+            using result_t = decltype(std::declval<FUNC>()(get<0>(std::declval<TUP>())));
+            static_assert((std::is_same_v<result_t, decltype(std::declval<FUNC>()(get<indices>(std::declval<TUP>())))> &&
+                           ...),
+                          "visit_at requires the function to return the same type for every element");
+
+            template <size_t index>
+            static constexpr result_t
+            call(TUP &&tup, FUNC &&f)
+            {
+                return std::forward<FUNC>(f)(get<index>(std::forward<TUP>(tup)));
+            }
+
+            static constexpr result_t (*table[])(TUP &&, FUNC &&) = {&call<indices>...};
+        };
+    } // namespace detail
+
+    // Calls f with the element at runtime index i, throws std::out_of_range if i >= tuple_size_v.
+    template <typename TUP, typename FUNC>
+    constexpr decltype(auto)
+    visit_at(TUP &&tup, size_t i, FUNC &&f)
+    {
+        constexpr size_t n_elems = tuple_size_v<std::remove_cvref_t<TUP>>;
+        static_assert(n_elems > 0, "visit_at requires a non-empty tuple");
+        if (i >= n_elems)
+        {
+            throw std::out_of_range("visit_at: index out of range");
+        }
+        using table_t = detail::visit_at_table<TUP, FUNC, std::make_index_sequence<n_elems>>;
+        return table_t::table[i](std::forward<TUP>(tup), std::forward<FUNC>(f));
+    }
+
+    ////////////////////////////////////////////////////////////
+    ////////////////  comparison and hashing  //////////////////
+    ////////////////////////////////////////////////////////////
+
+    // Types whose values are equal exactly if their bytes are equal. Tuples of such types without padding are compared
+    // with a single memcmp and hashed over their raw bytes. Floating point types are excluded (0.0 == -0.0, NaN != NaN)
+    // and so are class types, as their operator== may compare less than all bytes. Specialize for your own types.
+    template <typename T>
+    struct is_bytewise_comparable
+        : std::bool_constant<std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>>
+    {
+    };
+
+    template <typename... ELEMS>
+    struct is_bytewise_comparable<Tuple<ELEMS...>>
+        : std::bool_constant<(is_bytewise_comparable<ELEMS>::value && ...) &&
+                             std::has_unique_object_representations_v<Tuple<ELEMS...>>>
+    {
+    };
+
+    template <typename T>
+    static constexpr bool is_bytewise_comparable_v = is_bytewise_comparable<T>::value;
+
+    namespace detail
+    {
+        template <typename TUP1, typename TUP2, size_t... indices>
+        constexpr bool
+        equal_impl(const TUP1 &lhs, const TUP2 &rhs, std::index_sequence<indices...>)
+        {
+            return ((get<indices>(lhs) == get<indices>(rhs)) && ...);
+        }
+
+        template <typename TUP1, typename TUP2, size_t... indices>
+        constexpr auto
+        three_way_impl(const TUP1 &lhs, const TUP2 &rhs, std::index_sequence<indices...>)
+        {
+            using result_t = std::common_comparison_category_t<
+                std::compare_three_way_result_t<decltype(get<indices>(lhs)), decltype(get<indices>(rhs))>...>;
+            result_t result = std::strong_ordering::equal;
+            // stops at the first element that is not equal
+            (((result = get<indices>(lhs) <=> get<indices>(rhs)) == 0) && ...);
+            return result;
+        }
+
+        // Hashes the bytes 8 at a time: every word is mixed into the state with a multiplication, a final
+        // multiply-xorshift spreads the entropy of the high bits to the low bits used by hash tables.
+        inline size_t
+        hash_bytes(const void *data, size_t n_bytes)
+        {
+            constexpr uint64_t k     = 0x9e3779b97f4a7c15ULL;
+            const auto        *bytes = static_cast<const unsigned char *>(data);
+            uint64_t           h     = n_bytes * k;
+            for (; n_bytes >= sizeof(uint64_t); n_bytes -= sizeof(uint64_t), bytes += sizeof(uint64_t))
+            {
+                uint64_t word;
+                std::memcpy(&word, bytes, sizeof(uint64_t));
+                h = (h ^ word) * k;
+            }
+            if (n_bytes > 0)
+            {
+                uint64_t word = 0;
+                std::memcpy(&word, bytes, n_bytes);
+                h = (h ^ word) * k;
+            }
+            h ^= h >> 32;
+            h *= k;
+            h ^= h >> 29;
+            return h;
+        }
+
+        inline size_t
+        hash_combine(size_t seed, size_t h)
+        {
+            return seed ^ (h + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+        }
+    } // namespace detail
+
+    template <typename... ELEMS1, typename... ELEMS2>
+        requires(sizeof...(ELEMS1) == sizeof...(ELEMS2))
+    constexpr bool
+    operator==(const Tuple<ELEMS1...> &lhs, const Tuple<ELEMS2...> &rhs)
+    {
+        if constexpr (std::is_same_v<Tuple<ELEMS1...>, Tuple<ELEMS2...>> && is_bytewise_comparable_v<Tuple<ELEMS1...>>)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                return std::memcmp(&lhs, &rhs, sizeof(lhs)) == 0;
+            }
+        }
+        return detail::equal_impl(lhs, rhs, std::index_sequence_for<ELEMS1...>{});
+    }
+
+    // lexicographic comparison, the result is the weakest comparison category of the elements
+    template <typename... ELEMS1, typename... ELEMS2>
+        requires(sizeof...(ELEMS1) == sizeof...(ELEMS2))
+    constexpr auto
+    operator<=>(const Tuple<ELEMS1...> &lhs, const Tuple<ELEMS2...> &rhs)
+    {
+        return detail::three_way_impl(lhs, rhs, std::index_sequence_for<ELEMS1...>{});
+    }
+
+    ////////////////////////////////////////////////////////////
+    //////////////////////  packed_tuple  //////////////////////
+    ////////////////////////////////////////////////////////////
+
+    namespace detail
+    {
+        // alignment of an element as stored in a tuple, references are stored as pointers
+        template <typename T>
+        static constexpr size_t storage_alignment_v =
+            std::is_reference_v<T> ? alignof(std::remove_reference_t<T> *) : alignof(T);
+
+        // Computes the order in which the elements of a packed_tuple are stored: sorted by descending alignment, keeping
+        // the declaration order for elements with the same alignment.
+        template <typename... ELEMS>
+        struct packed_layout
+        {
+            static constexpr size_t n_elems = sizeof...(ELEMS);
+
+            // physical_to_logical[i] is the (logical) index of the element that is stored at position i
+            static constexpr std::array<size_t, n_elems> physical_to_logical = []() {
+                std::array<size_t, n_elems> alignments{storage_alignment_v<ELEMS>...};
+                std::array<size_t, n_elems> order{};
+                for (size_t i = 0; i < n_elems; ++i)
+                {
+                    // insertion sort, stable
+                    size_t j = i;
+                    for (; j > 0 && alignments[order[j - 1]] < alignments[i]; --j)
+                    {
+                        order[j] = order[j - 1];
+                    }
+                    order[j] = i;
+                }
+                return order;
+            }();
+
+            // logical_to_physical[i] is the position at which the element with (logical) index i is stored
+            static constexpr std::array<size_t, n_elems> logical_to_physical = []() {
+                std::array<size_t, n_elems> positions{};
+                for (size_t i = 0; i < n_elems; ++i)
+                {
+                    positions[physical_to_logical[i]] = i;
+                }
+                return positions;
+            }();
+
+            template <typename INDEX_SEQ>
+            struct storage;
+
+            template <size_t... positions>
+            struct storage<std::index_sequence<positions...>>
+                : has_type<Tuple<at_t<type_list<ELEMS...>, physical_to_logical[positions]>...>>
+            {
+            };
+
+            using storage_t = typename storage<std::make_index_sequence<n_elems>>::type;
+        };
+    } // namespace detail
+
+    // A tuple that stores its elements ordered by descending alignment, minimizing the padding between them. The
+    // elements are still accessed by the index in which they are declared:
+    // get<1>(packed_tuple<char, double, char, int>) returns the double, which is stored first.
+    template <typename... ELEMS>
+    struct packed_tuple
+    {
+        using layout = detail::packed_layout<ELEMS...>;
+
+        constexpr packed_tuple() = default;
+
+        template <typename T, typename... Ts>
+            requires(sizeof...(Ts) + 1 == sizeof...(ELEMS))
+        explicit constexpr packed_tuple(T &&e1, Ts &&...rest)
+            : packed_tuple(std::make_index_sequence<sizeof...(ELEMS)>{},
+                           forward_as_tuple(std::forward<T>(e1), std::forward<Ts>(rest)...))
+        {
+        }
+
+        // the elements in storage order, use get to access them by their logical index
+        typename layout::storage_t storage;
+
+      private:
+        template <size_t... positions, typename FWD_TUPLE>
+        constexpr packed_tuple(std::index_sequence<positions...>, FWD_TUPLE &&fwd)
+            : storage(get<layout::physical_to_logical[positions]>(std::forward<FWD_TUPLE>(fwd))...)
+        {
+        }
+    };
+
+    template <typename T, typename... Ts>
+    packed_tuple(T e1, Ts... rest) -> packed_tuple<std::unwrap_ref_decay_t<T>, std::unwrap_ref_decay_t<Ts>...>;
+
+    template <typename... ELEMS>
+    constexpr auto
+    make_packed_tuple(ELEMS &&...elems)
+    {
+        return packed_tuple<std::unwrap_ref_decay_t<ELEMS>...>{std::forward<ELEMS>(elems)...};
+    }
+
+    template <typename... ELEMS>
+    struct tuple_size<packed_tuple<ELEMS...>> : std::integral_constant<size_t, sizeof...(ELEMS)>
+    {
+    };
+
+    namespace detail
+    {
+        template <size_t i, typename... ELEMS>
+        struct get_impl<i, packed_tuple<ELEMS...>>
+        {
+            template <typename T>
+            constexpr static decltype(auto)
+            get(T &&t)
+            {
+                constexpr size_t position = packed_layout<ELEMS...>::logical_to_physical[i];
+                return bits_of_q::get<position>(std::forward<T>(t).storage);
+            }
+        };
+    } // namespace detail
+
+    ////////////////////////////////////////////////////////////
+    ////////////////  is_trivially_relocatable  ////////////////
+    ////////////////////////////////////////////////////////////
+
+    // Whether an object of type T can be moved to another location by copying its bytes (e.g. with memcpy) and then
+    // forgetting about the original, without running a move constructor and destructor. Containers can use this to
+    // reallocate with a single memcpy. Trivially copyable types are trivially relocatable, specialize this for other
+    // types that are, e.g. because they only hold a pointer to memory they own.
+    template <typename T>
+    struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T>>
+    {
+    };
+
+    // a reference element is stored as a pointer
+    template <typename T>
+    struct is_trivially_relocatable<T &> : std::true_type
+    {
+    };
+
+    template <typename T>
+    struct is_trivially_relocatable<T &&> : std::true_type
+    {
+    };
+
+    template <typename T>
+    struct is_trivially_relocatable<std::unique_ptr<T>> : std::true_type
+    {
+    };
+
+    template <typename... ELEMS>
+    struct is_trivially_relocatable<Tuple<ELEMS...>> : std::conjunction<is_trivially_relocatable<ELEMS>...>
+    {
+    };
+
+    template <typename... ELEMS>
+    struct is_trivially_relocatable<packed_tuple<ELEMS...>> : std::conjunction<is_trivially_relocatable<ELEMS>...>
+    {
+    };
+
+    template <typename T>
+    static constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
 } // namespace bits_of_q
 
+namespace std
+{
+    // The common reference and common type of two Tuples are the Tuples of the common references and common types of
+    // their elements, like for std::tuple since C++23. With these, a Tuple of references (e.g. the rows of a
+    // tuple_vector) and a Tuple of values have a common reference, as std::indirectly_readable requires of iterators.
+    template <typename... Ts, typename... Us, template <typename> class TQUAL, template <typename> class UQUAL>
+        requires(sizeof...(Ts) == sizeof...(Us)) &&
+                requires { typename bits_of_q::Tuple<common_reference_t<TQUAL<Ts>, UQUAL<Us>>...>; }
+    struct basic_common_reference<bits_of_q::Tuple<Ts...>, bits_of_q::Tuple<Us...>, TQUAL, UQUAL>
+    {
+        using type = bits_of_q::Tuple<common_reference_t<TQUAL<Ts>, UQUAL<Us>>...>;
+    };
+
+    template <typename... Ts, typename... Us>
+        requires(sizeof...(Ts) == sizeof...(Us)) && requires { typename bits_of_q::Tuple<common_type_t<Ts, Us>...>; }
+    struct common_type<bits_of_q::Tuple<Ts...>, bits_of_q::Tuple<Us...>>
+    {
+        using type = bits_of_q::Tuple<common_type_t<Ts, Us>...>;
+    };
+
+    // makes Tuples usable as keys of std::unordered_map, if std::hash supports all of their elements
+    template <typename... ELEMS>
+    struct hash<bits_of_q::Tuple<ELEMS...>>
+    {
+        size_t
+        operator()(const bits_of_q::Tuple<ELEMS...> &tup) const
+        {
+            if constexpr (bits_of_q::is_bytewise_comparable_v<bits_of_q::Tuple<ELEMS...>>)
+            {
+                return bits_of_q::detail::hash_bytes(&tup, sizeof(tup));
+            }
+            else
+            {
+                size_t seed = 0;
+                bits_of_q::apply(
+                    [&seed](const auto &...elems) {
+                        ((seed = bits_of_q::detail::hash_combine(
+                              seed, hash<std::remove_cvref_t<decltype(elems)>>{}(elems))),
+                         ...);
+                    },
+                    tup);
+                return seed;
+            }
+        }
+    };
+} // namespace std
+
 #endif // BOQ_TUPLE_H
@@ -0,0 +1,289 @@
+#ifndef BOQ_TUPLE_VECTOR_H
+#define BOQ_TUPLE_VECTOR_H
+
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Metaprogramming.h"
+#include "Tuple.h"
+
+namespace bits_of_q
+{
+
+    // A sequence of Tuple<ELEMS...> stored as a structure of arrays: every element type is stored in its own contiguous
+    // array (column). Loops that only touch a few of the elements therefore only load the memory of those columns.
+    // Accessing a "row" returns a proxy Tuple of references to the elements in the different columns, which works
+    // with get like any other Tuple.
+    template <typename... ELEMS>
+    class tuple_vector
+    {
+        static_assert(sizeof...(ELEMS) > 0, "a tuple_vector needs at least one column");
+        static_assert(!contains_type_v<bool, type_list<ELEMS...>>,
+                      "bool columns are not supported, as std::vector<bool> can't provide a contiguous column");
+
+      public:
+        using value_type      = Tuple<ELEMS...>;
+        using reference       = Tuple<ELEMS &...>;
+        using const_reference = Tuple<const ELEMS &...>;
+        using size_type       = size_t;
+
+        template <bool is_const>
+        class iterator_t;
+        using iterator       = iterator_t<false>;
+        using const_iterator = iterator_t<true>;
+
+        tuple_vector() = default;
+
+        size_t
+        size() const
+        {
+            return get<0>(m_columns).size();
+        }
+
+        bool
+        empty() const
+        {
+            return size() == 0;
+        }
+
+        void
+        reserve(size_t capacity)
+        {
+            for_each_column([capacity](auto &column) { column.reserve(capacity); });
+        }
+
+        void
+        clear()
+        {
+            for_each_column([](auto &column) { column.clear(); });
+        }
+
+        template <typename TUP>
+            requires std::is_same_v<std::remove_cvref_t<TUP>, value_type>
+        void
+        push_back(TUP &&tup)
+        {
+            push_back_impl(std::forward<TUP>(tup), std::index_sequence_for<ELEMS...>{});
+        }
+
+        template <typename... Ts>
+            requires(sizeof...(Ts) == sizeof...(ELEMS))
+        void
+        emplace_back(Ts &&...elems)
+        {
+            emplace_back_impl(std::index_sequence_for<ELEMS...>{}, std::forward<Ts>(elems)...);
+        }
+
+        reference
+        operator[](size_t i)
+        {
+            return row<reference>(*this, i, std::index_sequence_for<ELEMS...>{});
+        }
+
+        const_reference
+        operator[](size_t i) const
+        {
+            return row<const_reference>(*this, i, std::index_sequence_for<ELEMS...>{});
+        }
+
+        // contiguous view on all elements with index column_index
+        template <size_t column_index>
+        auto
+        column()
+        {
+            return std::span{get<column_index>(m_columns)};
+        }
+
+        template <size_t column_index>
+        auto
+        column() const
+        {
+            return std::span{get<column_index>(m_columns)};
+        }
+
+        iterator
+        begin()
+        {
+            return iterator{this, 0};
+        }
+        iterator
+        end()
+        {
+            return iterator{this, size()};
+        }
+        const_iterator
+        begin() const
+        {
+            return const_iterator{this, 0};
+        }
+        const_iterator
+        end() const
+        {
+            return const_iterator{this, size()};
+        }
+
+      private:
+        Tuple<std::vector<ELEMS>...> m_columns;
+
+        template <typename FUNC>
+        void
+        for_each_column(const FUNC &f)
+        {
+            static_for<0, sizeof...(ELEMS)>([&](auto i) { f(get<i.value>(m_columns)); });
+        }
+
+        template <typename TUP, size_t... indices>
+        void
+        push_back_impl(TUP &&tup, std::index_sequence<indices...> seq)
+        {
+            emplace_back_impl(seq, get<indices>(std::forward<TUP>(tup))...);
+        }
+
+        // The columns grow one after the other. If one of them throws (bad_alloc or a throwing constructor), the
+        // columns that already grew are shrunk again, so all columns keep the same size.
+        template <size_t... indices, typename... Ts>
+        void
+        emplace_back_impl(std::index_sequence<indices...>, Ts &&...elems)
+        {
+            size_t n_grown = 0;
+            try
+            {
+                ((get<indices>(m_columns).emplace_back(std::forward<Ts>(elems)), ++n_grown), ...);
+            }
+            catch (...)
+            {
+                static_for<0, sizeof...(ELEMS)>([&](auto i) {
+                    if (i.value < n_grown)
+                    {
+                        get<i.value>(m_columns).pop_back();
+                    }
+                });
+                throw;
+            }
+        }
+
+        template <typename REF, typename SELF, size_t... indices>
+        static REF
+        row(SELF &self, size_t i, std::index_sequence<indices...>)
+        {
+            return REF{get<indices>(self.m_columns)[i]...};
+        }
+    };
+
+    // Iterator over the rows of a tuple_vector, dereferencing to a proxy Tuple of references. It models
+    // std::random_access_iterator (the proxies have a common reference with the value type, see Tuple.h), so a
+    // tuple_vector works with the std::ranges algorithms and views that only read the rows. The proxies can't be
+    // assigned or swapped like the references of a container of Tuples though, so algorithms permuting the rows
+    // (std::sort, std::reverse, ...) don't work. For the classic iterator requirements, which need a real reference,
+    // it is therefore only advertised as an input iterator.
+    template <typename... ELEMS>
+    template <bool is_const>
+    class tuple_vector<ELEMS...>::iterator_t
+    {
+        using container_t = std::conditional_t<is_const, const tuple_vector, tuple_vector>;
+
+      public:
+        using iterator_category = std::input_iterator_tag;
+        using iterator_concept  = std::random_access_iterator_tag;
+        using value_type        = tuple_vector::value_type;
+        using difference_type   = std::ptrdiff_t;
+        using reference         = std::conditional_t<is_const, tuple_vector::const_reference, tuple_vector::reference>;
+
+        iterator_t() = default;
+        iterator_t(container_t *container, size_t index) : m_container(container), m_index(index)
+        {
+        }
+
+        reference
+        operator*() const
+        {
+            return (*m_container)[m_index];
+        }
+        reference
+        operator[](difference_type n) const
+        {
+            return (*m_container)[m_index + static_cast<size_t>(n)];
+        }
+
+        iterator_t &
+        operator++()
+        {
+            ++m_index;
+            return *this;
+        }
+        iterator_t
+        operator++(int)
+        {
+            iterator_t old = *this;
+            ++m_index;
+            return old;
+        }
+        iterator_t &
+        operator--()
+        {
+            --m_index;
+            return *this;
+        }
+        iterator_t
+        operator--(int)
+        {
+            iterator_t old = *this;
+            --m_index;
+            return old;
+        }
+        iterator_t &
+        operator+=(difference_type n)
+        {
+            m_index += static_cast<size_t>(n);
+            return *this;
+        }
+        iterator_t &
+        operator-=(difference_type n)
+        {
+            m_index -= static_cast<size_t>(n);
+            return *this;
+        }
+        friend iterator_t
+        operator+(iterator_t it, difference_type n)
+        {
+            return it += n;
+        }
+        friend iterator_t
+        operator+(difference_type n, iterator_t it)
+        {
+            return it += n;
+        }
+        friend iterator_t
+        operator-(iterator_t it, difference_type n)
+        {
+            return it -= n;
+        }
+        friend difference_type
+        operator-(const iterator_t &lhs, const iterator_t &rhs)
+        {
+            return static_cast<difference_type>(lhs.m_index) - static_cast<difference_type>(rhs.m_index);
+        }
+        friend bool
+        operator==(const iterator_t &lhs, const iterator_t &rhs)
+        {
+            return lhs.m_index == rhs.m_index;
+        }
+        friend auto
+        operator<=>(const iterator_t &lhs, const iterator_t &rhs)
+        {
+            return lhs.m_index <=> rhs.m_index;
+        }
+
+      private:
+        container_t *m_container = nullptr;
+        size_t       m_index     = 0;
+    };
+
+} // namespace bits_of_q
+
+#endif // BOQ_TUPLE_VECTOR_H
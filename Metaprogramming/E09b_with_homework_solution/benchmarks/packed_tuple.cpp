@@ -0,0 +1,67 @@
+// Benchmarks iterating over large arrays of tuples with padding-heavy element types, comparing packed_tuple (storage
+// ordered by alignment) with Tuple and std::tuple (storage in declaration order).
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "../Benchmark.h"
+#include "../Tuple.h"
+
+namespace boq = bits_of_q;
+using boq::benchmark::Benchmark;
+using boq::benchmark::do_not_optimize;
+
+namespace
+{
+    constexpr size_t n_tuples = 4'000'000;
+
+    template <template <typename...> class TUPLE>
+    void
+    benchmark_array(const std::string &name)
+    {
+        using tuple_t = TUPLE<char, double, char, int>;
+        std::printf("%-40s %zu bytes/tuple\n", name.c_str(), sizeof(tuple_t));
+
+        std::vector<tuple_t> tuples(n_tuples);
+        for (size_t i = 0; i < n_tuples; ++i)
+        {
+            get<0>(tuples[i]) = 'a';
+            get<1>(tuples[i]) = static_cast<double>(i);
+            get<3>(tuples[i]) = static_cast<int>(i % 1000);
+        }
+
+        Benchmark::run(name + " sum int", 20, [&]() {
+            long sum = 0;
+            for (const auto &t : tuples)
+            {
+                sum += get<3>(t);
+            }
+            do_not_optimize(sum);
+        });
+        Benchmark::run(name + " sum double, int", 20, [&]() {
+            double sum = 0;
+            for (const auto &t : tuples)
+            {
+                sum += get<1>(t) * get<3>(t);
+            }
+            do_not_optimize(sum);
+        });
+        Benchmark::run(name + " copy", 20, [&]() {
+            std::vector<tuple_t> copy = tuples;
+            do_not_optimize(copy.data());
+        });
+    }
+} // namespace
+
+int
+main()
+{
+    Benchmark::print_header();
+    benchmark_array<boq::packed_tuple>("boq::packed_tuple");
+    benchmark_array<boq::Tuple>("boq::Tuple");
+    benchmark_array<std::tuple>("std::tuple");
+    return 0;
+}
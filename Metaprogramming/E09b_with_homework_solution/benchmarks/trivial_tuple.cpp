@@ -0,0 +1,69 @@
+// Benchmarks growing and copying a std::vector of Tuple<int, double, float>, against std::tuple and a plain struct.
+// As Tuple is trivially copyable for trivial elements, std::vector can reallocate and copy it with memmove/memcpy just
+// like the plain struct. std::tuple is not trivially copyable (its assignment operators are user-provided).
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "../Benchmark.h"
+#include "../Tuple.h"
+
+namespace boq = bits_of_q;
+using boq::benchmark::Benchmark;
+using boq::benchmark::do_not_optimize;
+
+namespace
+{
+    constexpr size_t n_elems      = 1'000'000;
+    constexpr size_t n_iterations = 20;
+
+    struct plain_struct
+    {
+        int    i;
+        double d;
+        float  f;
+    };
+
+    template <typename T>
+    void
+    benchmark_vector(const std::string &name, const T &value)
+    {
+        std::printf("%-40s trivially copyable: %d, trivially relocatable: %d\n", name.c_str(),
+                    std::is_trivially_copyable_v<T>, boq::is_trivially_relocatable_v<T>);
+
+        Benchmark::run(name + " push_back growth", n_iterations, [&]() {
+            std::vector<T> v;
+            for (size_t i = 0; i < n_elems; ++i)
+            {
+                v.push_back(value);
+            }
+            do_not_optimize(v.data());
+        });
+
+        std::vector<T> source(n_elems, value);
+        Benchmark::run(name + " copy", n_iterations, [&]() {
+            std::vector<T> copy = source;
+            do_not_optimize(copy.data());
+        });
+        Benchmark::run(name + " assign", n_iterations, [&]() {
+            std::vector<T> copy(n_elems, value);
+            do_not_optimize(copy.data());
+            copy = source;
+            do_not_optimize(copy.data());
+        });
+    }
+} // namespace
+
+int
+main()
+{
+    Benchmark::print_header();
+    benchmark_vector("boq::Tuple", boq::Tuple<int, double, float>{1, 2.0, 3.0F});
+    benchmark_vector("std::tuple", std::tuple<int, double, float>{1, 2.0, 3.0F});
+    benchmark_vector("plain struct", plain_struct{1, 2.0, 3.0F});
+    return 0;
+}
@@ -0,0 +1,130 @@
+// Benchmarks std::unordered_map lookups with composite keys: Tuple keys against std::tuple keys. std::hash has no
+// specialization for std::tuple, so the std::tuple keys use the usual hash_combine over the elements. Tuple keys of
+// integers have no padding, so they are hashed over their raw bytes and compared with memcmp; keys containing a
+// std::string fall back to combining the element hashes.
+
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "../Benchmark.h"
+#include "../Tuple.h"
+
+namespace boq = bits_of_q;
+using boq::benchmark::Benchmark;
+using boq::benchmark::do_not_optimize;
+
+namespace
+{
+    constexpr size_t n_keys    = 10'000;
+    constexpr size_t n_lookups = 1'000'000;
+
+    struct std_tuple_hash
+    {
+        template <typename... ELEMS>
+        size_t
+        operator()(const std::tuple<ELEMS...> &tup) const
+        {
+            return std::apply(
+                [](const auto &...elems) {
+                    size_t seed = 0;
+                    ((seed = boq::detail::hash_combine(seed, std::hash<std::remove_cvref_t<decltype(elems)>>{}(elems))),
+                     ...);
+                    return seed;
+                },
+                tup);
+        }
+    };
+
+    template <typename MAP, typename MAKE_KEY>
+    void
+    benchmark_lookups(const std::string &name, const MAKE_KEY &make_key)
+    {
+        MAP map;
+        for (uint32_t i = 0; i < n_keys; ++i)
+        {
+            map.emplace(make_key(i), i);
+        }
+
+        std::mt19937                            rng{42};
+        std::uniform_int_distribution<uint32_t> distribution{0, 2 * n_keys - 1}; // half of the lookups miss
+        std::vector<typename MAP::key_type>     keys;
+        keys.reserve(n_lookups);
+        for (size_t i = 0; i < n_lookups; ++i)
+        {
+            keys.push_back(make_key(distribution(rng)));
+        }
+
+        size_t next = 0;
+        Benchmark::run(name, 10 * n_lookups, [&]() {
+            do_not_optimize(map.count(keys[next]));
+            next = next + 1 == n_lookups ? 0 : next + 1;
+        });
+    }
+
+    // hashing and comparing alone, without the cache misses and the modulo of the hash map
+    template <typename KEY, typename HASH, typename MAKE_KEY>
+    void
+    benchmark_hash_and_equality(const std::string &name, const MAKE_KEY &make_key)
+    {
+        // a successful lookup compares equal keys, which is the worst case for comparing element by element
+        std::vector<KEY> keys;
+        keys.reserve(n_keys);
+        for (uint32_t i = 0; i < n_keys; ++i)
+        {
+            keys.push_back(make_key(i));
+        }
+        std::vector<KEY> equal_keys = keys;
+
+        Benchmark::run(name + " hash", 100, [&]() {
+            size_t sum = 0;
+            for (const auto &key : keys)
+            {
+                sum += HASH{}(key);
+            }
+            do_not_optimize(sum);
+        });
+        Benchmark::run(name + " ==", 100, [&]() {
+            size_t n_equal = 0;
+            for (size_t i = 0; i < keys.size(); ++i)
+            {
+                n_equal += keys[i] == equal_keys[i];
+            }
+            do_not_optimize(n_equal);
+        });
+    }
+} // namespace
+
+int
+main()
+{
+    Benchmark::print_header();
+
+    auto make_boq_key = [](uint32_t i) { return boq::Tuple<uint32_t, uint32_t, uint64_t>{i, i * 7, uint64_t{i} << 20}; };
+    auto make_std_key = [](uint32_t i) { return std::tuple<uint32_t, uint32_t, uint64_t>{i, i * 7, uint64_t{i} << 20}; };
+    benchmark_hash_and_equality<boq::Tuple<uint32_t, uint32_t, uint64_t>, std::hash<boq::Tuple<uint32_t, uint32_t, uint64_t>>>(
+        "Tuple<u32, u32, u64>", make_boq_key);
+    benchmark_hash_and_equality<std::tuple<uint32_t, uint32_t, uint64_t>, std_tuple_hash>("std::tuple<u32, u32, u64>",
+                                                                                         make_std_key);
+
+    benchmark_lookups<std::unordered_map<boq::Tuple<uint32_t, uint32_t, uint64_t>, uint32_t>>(
+        "Tuple<u32, u32, u64> keys", [](uint32_t i) {
+            return boq::Tuple<uint32_t, uint32_t, uint64_t>{i, i * 7, uint64_t{i} << 20};
+        });
+    benchmark_lookups<std::unordered_map<std::tuple<uint32_t, uint32_t, uint64_t>, uint32_t, std_tuple_hash>>(
+        "std::tuple<u32, u32, u64> keys", [](uint32_t i) {
+            return std::tuple<uint32_t, uint32_t, uint64_t>{i, i * 7, uint64_t{i} << 20};
+        });
+
+    benchmark_lookups<std::unordered_map<boq::Tuple<std::string, uint32_t>, uint32_t>>(
+        "Tuple<string, u32> keys",
+        [](uint32_t i) { return boq::Tuple<std::string, uint32_t>{"key_" + std::to_string(i % 1000), i}; });
+    benchmark_lookups<std::unordered_map<std::tuple<std::string, uint32_t>, uint32_t, std_tuple_hash>>(
+        "std::tuple<string, u32> keys",
+        [](uint32_t i) { return std::tuple<std::string, uint32_t>{"key_" + std::to_string(i % 1000), i}; });
+    return 0;
+}
@@ -0,0 +1,80 @@
+// Memory benchmark comparing bits_of_q::Tuple with std::tuple for tuples holding stateless elements (comparators,
+// allocators, tag types, lambdas without captures). Prints the size of a single tuple and the memory used by, and the
+// time needed to fill, a vector of n_tuples of them.
+
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "../Benchmark.h"
+#include "../Tuple.h"
+
+namespace boq = bits_of_q;
+using boq::benchmark::Benchmark;
+using boq::benchmark::do_not_optimize;
+
+namespace
+{
+    constexpr size_t n_tuples = 1'000'000;
+
+    struct tag
+    {
+    };
+
+    constexpr auto hash = [](int i) { return static_cast<size_t>(i) * 31; };
+
+    template <typename TUPLE>
+    void
+    benchmark_memory(std::string_view name)
+    {
+        std::printf("%-40.*s %8zu bytes/tuple %10zu KiB per %zu tuples\n", static_cast<int>(name.size()), name.data(),
+                    sizeof(TUPLE), sizeof(TUPLE) * n_tuples / 1024, n_tuples);
+    }
+
+    template <typename TUPLE>
+    void
+    benchmark_fill(const std::string &name)
+    {
+        std::vector<TUPLE> tuples(n_tuples);
+        Benchmark::run(name + " fill", 10, [&]() {
+            for (auto &t : tuples)
+            {
+                get<0>(t) = 1;
+            }
+            do_not_optimize(tuples.data());
+        });
+    }
+
+    template <template <typename...> class TUPLE>
+    using with_comparator = TUPLE<int, std::less<>>;
+    template <template <typename...> class TUPLE>
+    using with_allocator = TUPLE<int, std::allocator<int>, std::less<>, tag>;
+    template <template <typename...> class TUPLE>
+    using with_lambda = TUPLE<int, decltype(hash), tag>;
+
+    template <template <typename...> class TUPLE>
+    void
+    benchmark_memory(const std::string &prefix)
+    {
+        benchmark_memory<with_comparator<TUPLE>>(prefix + "<int, less>");
+        benchmark_memory<with_allocator<TUPLE>>(prefix + "<int, allocator, less, tag>");
+        benchmark_memory<with_lambda<TUPLE>>(prefix + "<int, lambda, tag>");
+    }
+} // namespace
+
+int
+main()
+{
+    benchmark_memory<boq::Tuple>("boq::Tuple");
+    benchmark_memory<std::tuple>("std::tuple");
+
+    std::printf("\n");
+    Benchmark::print_header();
+    benchmark_fill<with_allocator<boq::Tuple>>("boq::Tuple<int, allocator, less, tag>");
+    benchmark_fill<with_allocator<std::tuple>>("std::tuple<int, allocator, less, tag>");
+    return 0;
+}
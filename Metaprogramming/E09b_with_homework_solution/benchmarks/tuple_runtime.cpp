@@ -0,0 +1,155 @@
+// Runtime benchmarks comparing bits_of_q::Tuple with std::tuple. Both are expected to perform identically: Tuple
+// stores each element in its own tuple_leaf base class (a flat list of bases, no recursion), so get is a single cast to
+// the leaf holding the element, which the compiler should optimize away entirely.
+//
+// CMake builds this file twice, once with -O2 and once with -O3.
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "../Benchmark.h"
+#include "../Tuple.h"
+
+namespace boq = bits_of_q;
+using boq::benchmark::Benchmark;
+using boq::benchmark::do_not_optimize;
+
+namespace
+{
+    constexpr uint64_t n_iterations = 10'000'000;
+
+    // Values the compiler can't see through, so the benchmarks can't be constant folded.
+    template <typename T>
+    T
+    opaque(T value)
+    {
+        do_not_optimize(value);
+        return value;
+    }
+
+    template <template <typename...> class PREDICATE, typename T>
+    auto
+    std_wrap_if(const T &e)
+    {
+        if constexpr (PREDICATE<T>::value)
+        {
+            return std::tuple<T>{e};
+        }
+        else
+        {
+            return std::tuple<>{};
+        }
+    }
+
+    // std::tuple has no transform or filter, these are the straightforward equivalents
+    template <typename TUP, typename FUNC>
+    auto
+    std_transform(const TUP &tup, const FUNC &f)
+    {
+        return std::apply([&](const auto &...elems) { return std::tuple{f(elems)...}; }, tup);
+    }
+
+    template <template <typename...> class PREDICATE, typename TUP>
+    auto
+    std_filter(const TUP &tup)
+    {
+        return std::apply([](const auto &...elems) { return std::tuple_cat(std_wrap_if<PREDICATE>(elems)...); }, tup);
+    }
+
+    template <template <typename...> class TUPLE>
+    auto
+    make_input()
+    {
+        return TUPLE<int, double, long, float, unsigned>{opaque(1), opaque(2.0), opaque(3L), opaque(4.0F),
+                                                         opaque(5U)};
+    }
+
+    template <template <typename...> class TUPLE, size_t n_tuples, typename CAT>
+    void
+    benchmark_tuple_cat(std::string_view name, const CAT &cat)
+    {
+        [&]<size_t... indices>(std::index_sequence<indices...>) {
+            std::array inputs{TUPLE<int, double>{opaque(int(indices)), opaque(double(indices))}...};
+            Benchmark::run(name, n_iterations / n_tuples, [&]() {
+                do_not_optimize(inputs);
+                auto result = cat(inputs[indices]...);
+                do_not_optimize(result);
+            });
+        }(std::make_index_sequence<n_tuples>{});
+    }
+
+    template <size_t n_tuples>
+    void
+    benchmark_tuple_cat()
+    {
+        std::string suffix = std::to_string(n_tuples) + " tuples";
+        benchmark_tuple_cat<boq::Tuple, n_tuples>("boq::tuple_cat " + suffix,
+                                                  [](const auto &...ts) { return boq::tuple_cat(ts...); });
+        benchmark_tuple_cat<std::tuple, n_tuples>("std::tuple_cat " + suffix,
+                                                  [](const auto &...ts) { return std::tuple_cat(ts...); });
+    }
+
+    constexpr auto twice = [](auto x) { return x + x; };
+} // namespace
+
+int
+main()
+{
+    Benchmark::print_header();
+
+    Benchmark::run("boq::get", n_iterations, []() {
+        auto t = make_input<boq::Tuple>();
+        do_not_optimize(t);
+        do_not_optimize(boq::get<0>(t) + boq::get<2>(t) + static_cast<long>(boq::get<4>(t)));
+    });
+    Benchmark::run("std::get", n_iterations, []() {
+        auto t = make_input<std::tuple>();
+        do_not_optimize(t);
+        do_not_optimize(std::get<0>(t) + std::get<2>(t) + static_cast<long>(std::get<4>(t)));
+    });
+
+    Benchmark::run("boq::Tuple construction", n_iterations, []() {
+        auto t = make_input<boq::Tuple>();
+        do_not_optimize(t);
+    });
+    Benchmark::run("std::tuple construction", n_iterations, []() {
+        auto t = make_input<std::tuple>();
+        do_not_optimize(t);
+    });
+
+    benchmark_tuple_cat<2>();
+    benchmark_tuple_cat<4>();
+    benchmark_tuple_cat<8>();
+    benchmark_tuple_cat<16>();
+
+    Benchmark::run("boq::transform", n_iterations, []() {
+        auto t = make_input<boq::Tuple>();
+        do_not_optimize(t);
+        auto result = boq::transform(t, twice);
+        do_not_optimize(result);
+    });
+    Benchmark::run("std::apply transform", n_iterations, []() {
+        auto t = make_input<std::tuple>();
+        do_not_optimize(t);
+        auto result = std_transform(t, twice);
+        do_not_optimize(result);
+    });
+
+    Benchmark::run("boq::filter", n_iterations, []() {
+        auto t = make_input<boq::Tuple>();
+        do_not_optimize(t);
+        auto result = boq::filter<std::is_integral>(t);
+        do_not_optimize(result);
+    });
+    Benchmark::run("std::apply filter", n_iterations, []() {
+        auto t = make_input<std::tuple>();
+        do_not_optimize(t);
+        auto result = std_filter<std::is_integral>(t);
+        do_not_optimize(result);
+    });
+    return 0;
+}
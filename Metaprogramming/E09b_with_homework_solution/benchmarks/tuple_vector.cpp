@@ -0,0 +1,86 @@
+// Benchmarks scanning one or two columns of a tuple_vector (structure of arrays) against the same scans over a
+// std::vector of Tuples (array of structures).
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "../Benchmark.h"
+#include "../Tuple.h"
+#include "../TupleVector.h"
+
+namespace boq = bits_of_q;
+using boq::benchmark::Benchmark;
+using boq::benchmark::do_not_optimize;
+
+namespace
+{
+    constexpr size_t n_records    = 4'000'000;
+    constexpr size_t n_iterations = 20;
+
+    // a typical record: an id, a price, a quantity and some data that is rarely used in hot loops
+    using record_t = boq::Tuple<uint64_t, double, int, char, double, double>;
+} // namespace
+
+int
+main()
+{
+    using boq::get;
+
+    std::vector<record_t>                                            aos;
+    boq::tuple_vector<uint64_t, double, int, char, double, double> soa;
+    aos.reserve(n_records);
+    soa.reserve(n_records);
+    for (size_t i = 0; i < n_records; ++i)
+    {
+        record_t r{uint64_t{i}, static_cast<double>(i % 100), static_cast<int>(i % 7), 'x', 0.0, 0.0};
+        aos.push_back(r);
+        soa.push_back(r);
+    }
+
+    Benchmark::print_header();
+    Benchmark::run("vector<Tuple> sum 1 column", n_iterations, [&]() {
+        double sum = 0;
+        for (const auto &r : aos)
+        {
+            sum += get<1>(r);
+        }
+        do_not_optimize(sum);
+    });
+    Benchmark::run("tuple_vector sum 1 column", n_iterations, [&]() {
+        double sum = 0;
+        for (double price : soa.column<1>())
+        {
+            sum += price;
+        }
+        do_not_optimize(sum);
+    });
+    Benchmark::run("tuple_vector sum 1 column (rows)", n_iterations, [&]() {
+        double sum = 0;
+        for (auto r : soa)
+        {
+            sum += get<1>(r);
+        }
+        do_not_optimize(sum);
+    });
+
+    Benchmark::run("vector<Tuple> sum 2 columns", n_iterations, [&]() {
+        double sum = 0;
+        for (const auto &r : aos)
+        {
+            sum += get<1>(r) * get<2>(r);
+        }
+        do_not_optimize(sum);
+    });
+    Benchmark::run("tuple_vector sum 2 columns", n_iterations, [&]() {
+        std::span<const double> prices     = std::as_const(soa).column<1>();
+        std::span<const int>    quantities = std::as_const(soa).column<2>();
+        double                  sum        = 0;
+        for (size_t i = 0; i < prices.size(); ++i)
+        {
+            sum += prices[i] * quantities[i];
+        }
+        do_not_optimize(sum);
+    });
+    return 0;
+}
@@ -0,0 +1,113 @@
+// Benchmarks a pipeline of transform, filter, transform, transform over a tuple of 8 payloads that only reads one
+// element of the result, comparing the eager functions (every stage builds a new Tuple) with the lazy views (only the
+// element that is read passes through the stages). Besides the timings it prints the copies per pipeline, counted with
+// CopyCounter, and the bytes of the intermediate objects that the pipeline keeps on the stack.
+
+#include <array>
+#include <cstdio>
+#include <type_traits>
+#include <utility>
+
+#define BOQ_NO_ALLOCATION_TRACKING
+#include "../Benchmark.h"
+#include "../TestUtilities.h"
+#include "../Tuple.h"
+
+namespace boq = bits_of_q;
+using boq::CopyCounter;
+using boq::CopyStats;
+using boq::benchmark::Benchmark;
+using boq::benchmark::do_not_optimize;
+
+namespace
+{
+    constexpr size_t n_iterations = 1'000'000;
+
+    template <size_t i>
+    struct payload
+    {
+        std::array<double, 16> values{};
+        CopyCounter            counter;
+    };
+
+    template <typename T>
+    struct is_even_payload;
+
+    template <size_t i>
+    struct is_even_payload<payload<i>> : std::bool_constant<i % 2 == 0>
+    {
+    };
+
+    // returns a scaled copy of the payload
+    const auto scale = []<size_t i>(const payload<i> &p) {
+        payload<i> result = p;
+        for (double &value : result.values)
+        {
+            value *= 1.5;
+        }
+        return result;
+    };
+
+    template <size_t... indices>
+    auto
+    make_payloads(std::index_sequence<indices...>)
+    {
+        return boq::Tuple<payload<indices>...>{payload<indices>{{static_cast<double>(indices)}, CopyCounter{}}...};
+    }
+
+    template <typename TUP>
+    double
+    eager_pipeline(const TUP &tup)
+    {
+        auto scaled  = boq::transform(tup, scale);
+        auto even    = boq::filter<is_even_payload>(scaled);
+        auto scaled2 = boq::transform(even, scale);
+        auto scaled3 = boq::transform(scaled2, scale);
+        return boq::get<1>(scaled3).values[0];
+    }
+
+    template <typename TUP>
+    auto
+    lazy_pipeline_view(const TUP &tup)
+    {
+        return boq::make_transform_view(
+            boq::make_transform_view(boq::make_filter_view<is_even_payload>(boq::make_transform_view(tup, scale)),
+                                     scale),
+            scale);
+    }
+
+    template <typename TUP>
+    double
+    lazy_pipeline(const TUP &tup)
+    {
+        return boq::get<1>(lazy_pipeline_view(tup)).values[0];
+    }
+} // namespace
+
+int
+main()
+{
+    auto tup = make_payloads(std::make_index_sequence<8>{});
+
+    // the eager pipeline holds one tuple of all 8 payloads and three tuples of the 4 even ones
+    using scaled_t               = decltype(boq::transform(tup, scale));
+    using even_t                 = decltype(boq::filter<is_even_payload>(std::declval<scaled_t &>()));
+    constexpr size_t eager_bytes = sizeof(scaled_t) + 3 * sizeof(even_t);
+    constexpr size_t lazy_bytes  = sizeof(decltype(lazy_pipeline_view(tup)));
+
+    CopyCounter::reset();
+    do_not_optimize(eager_pipeline(tup));
+    CopyStats eager_stats = CopyCounter::reset();
+    do_not_optimize(lazy_pipeline(tup));
+    CopyStats lazy_stats = CopyCounter::reset();
+
+    std::printf("%-40s copies: %d, moves: %d, intermediate bytes: %zu\n", "eager transform/filter", eager_stats.n_copies,
+                eager_stats.n_moves, eager_bytes);
+    std::printf("%-40s copies: %d, moves: %d, intermediate bytes: %zu\n", "lazy transform_view/filter_view",
+                lazy_stats.n_copies, lazy_stats.n_moves, lazy_bytes);
+
+    Benchmark::print_header();
+    Benchmark::run("eager transform/filter pipeline", n_iterations, [&]() { do_not_optimize(eager_pipeline(tup)); });
+    Benchmark::run("lazy view pipeline", n_iterations, [&]() { do_not_optimize(lazy_pipeline(tup)); });
+    return 0;
+}
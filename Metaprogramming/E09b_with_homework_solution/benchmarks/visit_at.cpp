@@ -0,0 +1,89 @@
+// Benchmarks accessing a tuple element by a runtime index: visit_at (function pointer table) against a linear search
+// with static_for comparing the index with every element index, for tuples of 8, 32 and 128 elements.
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../Benchmark.h"
+#include "../Metaprogramming.h"
+#include "../Tuple.h"
+
+namespace boq = bits_of_q;
+using boq::benchmark::Benchmark;
+using boq::benchmark::do_not_optimize;
+
+namespace
+{
+    constexpr size_t n_lookups = 1'000'000;
+
+    template <size_t i>
+    struct element
+    {
+        uint64_t value;
+    };
+
+    template <size_t... indices>
+    auto
+    make_tuple_of_elements(std::index_sequence<indices...>)
+    {
+        return boq::Tuple<element<indices>...>{element<indices>{indices * 3}...};
+    }
+
+    template <typename TUP, typename FUNC>
+    void
+    linear_visit_at(TUP &tup, size_t i, const FUNC &f)
+    {
+        boq::static_for<0, boq::tuple_size_v<TUP>>([&](auto index) {
+            if (static_cast<size_t>(index.value) == i)
+            {
+                f(boq::get<index.value>(tup));
+            }
+        });
+    }
+
+    template <size_t n_elems>
+    void
+    benchmark_visit_at()
+    {
+        auto tup = make_tuple_of_elements(std::make_index_sequence<n_elems>{});
+
+        std::mt19937_64                       rng{42};
+        std::uniform_int_distribution<size_t> distribution{0, n_elems - 1};
+        std::vector<size_t>                   indices(n_lookups);
+        for (auto &index : indices)
+        {
+            index = distribution(rng);
+        }
+
+        std::string suffix = " " + std::to_string(n_elems) + " elements";
+        Benchmark::run("visit_at" + suffix, 10, [&]() {
+            uint64_t sum = 0;
+            for (size_t i : indices)
+            {
+                boq::visit_at(tup, i, [&](const auto &elem) { sum += elem.value; });
+            }
+            do_not_optimize(sum);
+        });
+        Benchmark::run("static_for search" + suffix, 10, [&]() {
+            uint64_t sum = 0;
+            for (size_t i : indices)
+            {
+                linear_visit_at(tup, i, [&](const auto &elem) { sum += elem.value; });
+            }
+            do_not_optimize(sum);
+        });
+    }
+} // namespace
+
+int
+main()
+{
+    Benchmark::print_header();
+    benchmark_visit_at<8>();
+    benchmark_visit_at<32>();
+    benchmark_visit_at<128>();
+    return 0;
+}
@@ -0,0 +1,113 @@
+#!/usr/bin/perl
+
+# Verifies that the probe functions in a source file compile down to the expected (zero-overhead) assembly.
+#
+# usage: ./check_codegen.pl <object file> <source file>
+#
+# Every probe function in the source file is an extern "C" function preceded by a comment of the form
+#   // CHECK: max_instructions=<n> no_calls no_stack
+# The object file is disassembled with objdump and the body of each probe is checked against its constraints. Padding
+# instructions (nops) after the return are not counted. Only x86-64 is supported; on other architectures the check is
+# skipped.
+
+use strict;
+use warnings;
+
+if($#ARGV < 1){
+	print STDERR "usage: $0 <object file> <source file>\n";
+	exit 1;
+}
+
+my ($object, $source) = @ARGV;
+
+sub parse_checks{
+	my $file = shift;
+	my %checks;
+	my $pending;
+	open(my $fh, "<", $file) or die "can't open $file: $!";
+	while(my $line = <$fh>){
+		if($line =~ m{^\s*//\s*CHECK:\s*(.*)$}){
+			$pending = {};
+			foreach my $constraint (split(/\s+/, $1)){
+				if($constraint =~ /^(\w+)=(\d+)$/){
+					$pending->{$1} = $2;
+				}
+				else{
+					$pending->{$constraint} = 1;
+				}
+			}
+		}
+		elsif(defined($pending) && $line =~ /^\s*(\w+)\s*\(/){
+			$checks{$1} = $pending;
+			undef $pending;
+		}
+	}
+	close($fh);
+	return %checks;
+}
+
+sub disassemble{
+	my $file = shift;
+	my %functions;
+	my $current;
+	foreach my $line (`objdump -dr --no-show-raw-insn $file`){
+		chomp $line;
+		if($line =~ /^[0-9a-f]+ <(\w+)>:$/){
+			$current = $1;
+			$functions{$current} = [];
+		}
+		elsif(defined($current) && $line =~ /^\s+[0-9a-f]+:\s+(R_\S+)\s+(\S+)/){
+			push(@{$functions{$current}}, "reloc $1 $2");
+		}
+		elsif(defined($current) && $line =~ /^\s+[0-9a-f]+:\s+(\S.*)$/){
+			my $instruction = $1;
+			next if $instruction =~ /\bnop/ || $instruction =~ /^xchg\s+%ax,%ax/;
+			push(@{$functions{$current}}, $instruction);
+		}
+	}
+	return %functions;
+}
+
+my $arch = `objdump -f $object`;
+if($arch !~ /x86-64/){
+	print("skipping codegen checks: $object is not an x86-64 object file\n");
+	exit 0;
+}
+
+my %checks = parse_checks($source);
+my %functions = disassemble($object);
+my $failures = 0;
+
+foreach my $probe (sort keys %checks){
+	my $check = $checks{$probe};
+	my @errors;
+
+	if(!exists $functions{$probe}){
+		print("[  FAILED  ] $probe: not found in $object\n");
+		$failures++;
+		next;
+	}
+
+	my @body = @{$functions{$probe}};
+	my @instructions = grep { !/^reloc / } @body;
+	if(exists $check->{max_instructions} && @instructions > $check->{max_instructions}){
+		push(@errors, scalar(@instructions)." instructions, expected at most $check->{max_instructions}");
+	}
+	if(exists $check->{no_calls} && grep { /^call/ || /^reloc R_X86_64_(PLT32|PC32|GOTPCREL)/ } @body){
+		push(@errors, "contains a call");
+	}
+	if(exists $check->{no_stack} && grep { /^(push|pop)/ || /%[re]sp\b/ } @instructions){
+		push(@errors, "accesses the stack");
+	}
+
+	if(@errors){
+		print("[  FAILED  ] $probe: ".join(", ", @errors)."\n");
+		print("\t$_\n") foreach @body;
+		$failures++;
+	}
+	else{
+		print("[       OK ] $probe (".scalar(@instructions)." instructions)\n");
+	}
+}
+
+exit($failures > 0 ? 1 : 0);
@@ -0,0 +1,70 @@
+// Probe functions for check_codegen.pl. Every probe is preceded by a CHECK comment listing the constraints the
+// generated (-O2) assembly has to satisfy:
+//   max_instructions=<n>  the function body consists of at most n instructions (including the return)
+//   no_calls              the function doesn't call (or tail call) any other function
+//   no_stack              the function doesn't touch the stack (no push/pop, no stack pointer relative accesses)
+
+#include "../Tuple.h"
+
+namespace boq = bits_of_q;
+
+using Tuple2 = boq::Tuple<int, int>;
+using Tuple4 = boq::Tuple<int, int, int, int>;
+
+// CHECK: max_instructions=2 no_calls no_stack
+extern "C" int
+probe_get_first(const boq::Tuple<int, double, long> &t)
+{
+    return boq::get<0>(t);
+}
+
+// CHECK: max_instructions=2 no_calls no_stack
+extern "C" long
+probe_get_last(const boq::Tuple<int, double, long> &t)
+{
+    return boq::get<2>(t);
+}
+
+// CHECK: max_instructions=2 no_calls no_stack
+extern "C" void
+probe_get_store(boq::Tuple<int, double, long> &t, double value)
+{
+    boq::get<1>(t) = value;
+}
+
+// CHECK: max_instructions=3 no_calls no_stack
+extern "C" long
+probe_get_rvalue(boq::Tuple<int, long, long> &&t)
+{
+    long value = boq::get<1>(std::move(t));
+    return value + boq::get<2>(std::move(t));
+}
+
+// CHECK: max_instructions=10 no_calls no_stack
+extern "C" void
+probe_make_tuple(Tuple4 *out, int a, int b, int c, int d)
+{
+    *out = boq::make_tuple(a, b, c, d);
+}
+
+// CHECK: max_instructions=10 no_calls no_stack
+extern "C" void
+probe_tuple_cat_2(Tuple4 *out, const Tuple2 &t1, const Tuple2 &t2)
+{
+    *out = boq::tuple_cat(t1, t2);
+}
+
+// CHECK: max_instructions=12 no_calls no_stack
+extern "C" void
+probe_tuple_cat_4(Tuple4 *out, const boq::Tuple<int> &t1, const boq::Tuple<int> &t2, const boq::Tuple<int> &t3,
+                  const boq::Tuple<int> &t4)
+{
+    *out = boq::tuple_cat(t1, t2, t3, t4);
+}
+
+// CHECK: max_instructions=10 no_calls no_stack
+extern "C" void
+probe_tuple_cat_rvalue(Tuple4 *out, Tuple2 &&t1, Tuple2 &&t2)
+{
+    *out = boq::tuple_cat(std::move(t1), std::move(t2));
+}
@@ -0,0 +1,51 @@
+#!/usr/bin/perl
+
+# Measures the compile time of the benchmarks in this directory for increasing input sizes, using bits_of_q::Tuple
+# and std::tuple:
+#   tuple_get.cpp: get on every element of a tuple with N_ELEMENTS elements
+#   tuple_cat.cpp: tuple_cat of N_TUPLES tuples
+#
+# usage: ./time_tuple_builds.pl [n_compilations] [compiler]
+#   n_compilations: number of timed compilations per configuration, the median is reported (default: 5)
+#   compiler:       default g++
+
+use strict;
+use warnings;
+use Time::HiRes qw(time);
+
+my $n_compilations = $#ARGV >= 0 ? $ARGV[0] : 5;
+my $compiler = $#ARGV >= 1 ? $ARGV[1] : "g++";
+my @benchmarks = (
+	["tuple_get.cpp", "N_ELEMENTS", [16, 64, 256]],
+	["tuple_cat.cpp", "N_TUPLES", [8, 16, 32]],
+);
+
+sub median{
+	my @sorted = sort { $a <=> $b } @_;
+	my $n = @sorted;
+	return $n % 2 ? $sorted[$n / 2] : ($sorted[$n / 2 - 1] + $sorted[$n / 2]) / 2;
+}
+
+sub time_compilation{
+	my ($file, $flags) = @_;
+	my @samples;
+	foreach (1 .. $n_compilations){
+		my $start = time();
+		system("$compiler -O2 -std=c++20 $flags $file -o time_tuple_builds.out");
+		die "compilation failed\n" if $? != 0;
+		push(@samples, time() - $start);
+	}
+	return median(@samples);
+}
+
+foreach my $benchmark (@benchmarks){
+	my ($file, $macro, $sizes) = @$benchmark;
+	print("========= $file, $compiler, median of $n_compilations ==========\n");
+	printf("%-12s %14s %14s\n", $macro, "boq::Tuple", "std::tuple");
+	foreach my $n (@$sizes){
+		printf("%-12d %13.3fs %13.3fs\n", $n, time_compilation($file, "-D$macro=$n"),
+			time_compilation($file, "-D$macro=$n -DUSE_STD_TUPLE"));
+	}
+}
+
+unlink("time_tuple_builds.out");
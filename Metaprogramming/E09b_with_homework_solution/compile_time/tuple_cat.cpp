@@ -0,0 +1,52 @@
+// Compile time benchmark for tuple_cat: concatenates N_TUPLES tuples of 4 elements (of distinct types) each.
+// Compiled by time_tuple_builds.pl, define USE_STD_TUPLE to use std::tuple instead.
+
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+#include "../Tuple.h"
+
+#ifndef N_TUPLES
+#define N_TUPLES 32
+#endif
+
+template <size_t i>
+struct element
+{
+    size_t value;
+};
+
+#ifdef USE_STD_TUPLE
+using std::get;
+using std::tuple_cat;
+template <typename... Ts>
+using tuple_t = std::tuple<Ts...>;
+#else
+using bits_of_q::get;
+using bits_of_q::tuple_cat;
+template <typename... Ts>
+using tuple_t = bits_of_q::Tuple<Ts...>;
+#endif
+
+template <size_t i>
+auto
+make_input()
+{
+    return tuple_t<element<4 * i>, element<4 * i + 1>, element<4 * i + 2>, element<4 * i + 3>>{
+        element<4 * i>{i}, element<4 * i + 1>{i}, element<4 * i + 2>{i}, element<4 * i + 3>{i}};
+}
+
+template <size_t... indices>
+size_t
+cat_all(std::index_sequence<indices...>)
+{
+    auto t = tuple_cat(make_input<indices>()...);
+    return get<4 * sizeof...(indices) - 1>(t).value;
+}
+
+int
+main()
+{
+    return static_cast<int>(cat_all(std::make_index_sequence<N_TUPLES>{}));
+}
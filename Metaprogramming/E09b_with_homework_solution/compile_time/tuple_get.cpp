@@ -0,0 +1,42 @@
+// Compile time benchmark for Tuple: creates a tuple with N_ELEMENTS elements of distinct types and accesses every one
+// of them with get. Compiled by time_tuple_builds.pl, define USE_STD_TUPLE to use std::tuple instead.
+
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+#include "../Tuple.h"
+
+#ifndef N_ELEMENTS
+#define N_ELEMENTS 64
+#endif
+
+template <size_t i>
+struct element
+{
+    size_t value;
+};
+
+#ifdef USE_STD_TUPLE
+using std::get;
+template <typename... Ts>
+using tuple_t = std::tuple<Ts...>;
+#else
+using bits_of_q::get;
+template <typename... Ts>
+using tuple_t = bits_of_q::Tuple<Ts...>;
+#endif
+
+template <size_t... indices>
+size_t
+sum_all(std::index_sequence<indices...>)
+{
+    tuple_t<element<indices>...> t{element<indices>{indices}...};
+    return (get<indices>(t).value + ...);
+}
+
+int
+main()
+{
+    return static_cast<int>(sum_all(std::make_index_sequence<N_ELEMENTS>{}) % 256);
+}
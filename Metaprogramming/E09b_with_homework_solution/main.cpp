@@ -1,7 +1,12 @@
 #include "Metaprogramming.h"
 #include "TestUtilities.h"
 #include "Tuple.h"
+#include "TupleVector.h"
+#include <algorithm>
+#include <iterator>
+#include <ranges>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
 
 constexpr size_t boq_tuple = 1;
@@ -88,6 +93,512 @@ main()
             [&](auto i) { ASSERT_EQ(get<i.value>(boq_t1_2_3), get<i.value>(std_t1_2_3)); });
     });
 
+    Tester::test("get_on_large_tuple", []() {
+        auto tup = []<size_t... indices>(std::index_sequence<indices...>) {
+            return Tuple<std::integral_constant<size_t, indices>...>{std::integral_constant<size_t, indices>{}...};
+        }(std::make_index_sequence<64>{});
+
+        static_for<0, 64>([&](auto i) {
+            static_assert(std::is_same_v<decltype(get<i.value>(tup)), std::integral_constant<size_t, i.value> &>);
+        });
+        static_assert(std::is_same_v<decltype(get<63>(std::move(tup))), std::integral_constant<size_t, 63> &&>);
+    });
+
+    {
+        struct Empty
+        {
+        };
+        struct Empty2
+        {
+        };
+        auto lambda = [](int i) { return i + 1; };
+
+        // empty elements don't take up any space
+        static_assert(std::is_empty_v<Tuple<>>);
+        static_assert(std::is_empty_v<Tuple<Empty>>);
+        static_assert(std::is_empty_v<Tuple<Empty, Empty2, std::less<>>>);
+        static_assert(sizeof(Tuple<Empty, int>) == sizeof(int));
+        static_assert(sizeof(Tuple<int, Empty, std::less<>, decltype(lambda)>) == sizeof(int));
+        static_assert(sizeof(Tuple<Empty, double, Empty2, std::allocator<int>>) == sizeof(double));
+        // distinct objects of the same type need distinct addresses, so here one byte is needed for the second Empty
+        static_assert(sizeof(Tuple<Empty, Empty, int>) <= sizeof(std::tuple<Empty, Empty, int>));
+        static_assert(sizeof(Tuple<Tuple<Empty>, int>) == sizeof(int));
+    }
+
+    Tester::test("elements_dont_overlap_tail_padding", []() {
+        struct padded
+        {
+            int  a;
+            char b;
+        };
+        // only empty elements may overlap, the char must not be placed in the padding at the end of padded
+        static_assert(sizeof(Tuple<padded, char>) == sizeof(std::tuple<padded, char>));
+        Tuple<padded, char> tup{padded{1, 'a'}, 'y'};
+        get<0>(tup) = padded{2, 'b'};
+        ASSERT_EQ(get<1>(tup), 'y');
+        padded replacement{3, 'c'};
+        std::memcpy(&get<0>(tup), &replacement, sizeof(padded));
+        ASSERT_EQ(get<1>(tup), 'y');
+        ASSERT_EQ(get<0>(tup).a, 3);
+    });
+
+    {
+        // packed_tuple stores its elements by descending alignment, get still uses the declaration order
+        using layout = packed_tuple<char, double, char, int>::layout;
+        static_assert(layout::physical_to_logical == std::array<size_t, 4>{1, 3, 0, 2});
+        static_assert(layout::logical_to_physical == std::array<size_t, 4>{2, 0, 3, 1});
+        static_assert(std::is_same_v<layout::storage_t, Tuple<double, int, char, char>>);
+        static_assert(sizeof(packed_tuple<char, double, char, int>) < sizeof(Tuple<char, double, char, int>));
+
+        struct Empty
+        {
+        };
+        static_assert(sizeof(packed_tuple<>) <= sizeof(Tuple<>));
+        static_assert(sizeof(packed_tuple<char, int &, short>) <= sizeof(Tuple<char, int &, short>));
+        static_assert(sizeof(packed_tuple<Empty, char, Empty, long>) <= sizeof(Tuple<Empty, char, Empty, long>));
+        static_assert(sizeof(packed_tuple<bool, long double, float, bool, short, double>) <=
+                      sizeof(Tuple<bool, long double, float, bool, short, double>));
+        static_assert(sizeof(packed_tuple<int, int, int>) == sizeof(Tuple<int, int, int>));
+    }
+
+    TesterWithBuilder<1>::test("packed_tuple", [](auto &&builder) {
+        auto c1 = make_copy_counter<boq_tuple>();
+        auto c2 = make_copy_counter<std_tuple>();
+
+        auto &&packed    = builder.build(packed_tuple{'a', 4.2, c1, 'b', 42});
+        auto &&reference = builder.build(std::tuple{'a', 4.2, c2, 'b', 42});
+
+        ASSERT_EQ(c1, c2);
+        static_assert(tuple_size_v<std::remove_cvref_t<decltype(packed)>> == 5);
+        static_assert(std::is_same_v<tuple_element_t<std::remove_cvref_t<decltype(packed)>, 1>, double>);
+        static_assert(std::is_same_v<decltype(get<1>(std::forward<decltype(packed)>(packed))),
+                                     decltype(get<1>(std::forward<decltype(reference)>(reference)))>);
+
+        ASSERT_EQ(get<0>(packed), 'a');
+        ASSERT_EQ(get<1>(packed), 4.2);
+        ASSERT_EQ(get<3>(packed), 'b');
+        ASSERT_EQ(get<4>(packed), 42);
+        auto v1 = get<2>(std::forward<decltype(packed)>(packed));
+        auto v2 = get<2>(std::forward<decltype(reference)>(reference));
+        ASSERT_EQ(v1, v2);
+    });
+
+    Tester::test("tuple_vector", []() {
+        auto c = make_copy_counter();
+
+        tuple_vector<int, CopyCounter, double> v;
+        v.reserve(4);
+        v.push_back(Tuple{1, c, 1.5});
+        v.emplace_back(2, c, 2.5);
+        Tuple<int, CopyCounter, double> t{3, c, 3.5};
+        v.push_back(t);
+        c.reset();
+        v.push_back(std::move(t));
+
+        ASSERT_EQ(c.stats, (CopyStats{0, 0, 1}));
+        ASSERT_EQ(v.size(), 4U);
+        ASSERT_EQ(get<0>(v[2]), 3);
+        ASSERT_EQ(get<2>(v[3]), 3.5);
+
+        // rows are proxies referring to the elements in the columns
+        static_assert(std::is_same_v<decltype(v[0]), Tuple<int &, CopyCounter &, double &>>);
+        get<0>(v[1]) = 20;
+        ASSERT_EQ(v.column<0>()[1], 20);
+
+        std::span<double> doubles = v.column<2>();
+        ASSERT_EQ(doubles.size(), 4U);
+        ASSERT_EQ(doubles[0], 1.5);
+
+        int sum = 0;
+        for (auto row : std::as_const(v))
+        {
+            static_assert(std::is_same_v<decltype(row), Tuple<const int &, const CopyCounter &, const double &>>);
+            sum += get<0>(row);
+        }
+        ASSERT_EQ(sum, 1 + 20 + 3 + 3);
+        ASSERT_EQ(v.end() - v.begin(), 4);
+        static_assert(std::is_same_v<std::iterator_traits<decltype(v.begin())>::iterator_category,
+                                     std::input_iterator_tag>);
+
+        // the rows have a common reference with the value type, so the iterators model the iterator concepts and
+        // tuple_vector works with the std::ranges algorithms and views
+        static_assert(std::is_same_v<std::common_reference_t<Tuple<int &, double &> &&, Tuple<int, double> &>,
+                                     Tuple<int &, double &>>);
+        static_assert(std::input_iterator<tuple_vector<int, double>::iterator>);
+        static_assert(std::random_access_iterator<tuple_vector<int, double>::iterator>);
+        static_assert(std::random_access_iterator<tuple_vector<int, double>::const_iterator>);
+        static_assert(std::ranges::random_access_range<tuple_vector<int, double>>);
+        ASSERT_EQ(std::ranges::count_if(v, [](const auto &row) { return get<2>(row) > 2.0; }), 3);
+        auto firsts = v | std::views::transform([](const auto &row) { return get<0>(row); }) | std::views::reverse;
+        ASSERT_EQ(*firsts.begin(), 3);
+    });
+
+    Tester::test("tuple_vector_keeps_columns_aligned_when_a_column_throws", []() {
+        struct throws_on_negative
+        {
+            explicit throws_on_negative(int i_) : i(i_)
+            {
+                if (i < 0)
+                {
+                    throw std::invalid_argument("negative");
+                }
+            }
+            int i;
+        };
+
+        tuple_vector<std::string, throws_on_negative, double> v;
+        v.emplace_back("a", 1, 1.5);
+        bool thrown = false;
+        try
+        {
+            v.emplace_back("b", -1, 2.5);
+        }
+        catch (const std::invalid_argument &)
+        {
+            thrown = true;
+        }
+        ASSERT_EQ(thrown, true);
+        ASSERT_EQ(v.size(), 1U);
+        ASSERT_EQ(v.column<0>().size(), 1U);
+        ASSERT_EQ(v.column<1>().size(), 1U);
+        ASSERT_EQ(v.column<2>().size(), 1U);
+        v.emplace_back("c", 3, 3.5);
+        ASSERT_EQ(get<0>(v[1]), "c");
+        ASSERT_EQ(get<1>(v[1]).i, 3);
+    });
+
+    Tester::test("tuple_cat_moves_every_element_once", []() {
+        auto c = make_copy_counter();
+        Tuple<CopyCounter, int> t1{c, 1};
+        Tuple<>                 t2{};
+        Tuple<int, CopyCounter> t3{2, c};
+        Tuple<CopyCounter>      t4{c};
+        Tuple<CopyCounter, int> t5{c, 5};
+        c.reset();
+
+        auto result = tuple_cat(std::move(t1), t2, std::move(t3), std::move(t4), t5);
+
+        static_assert(std::is_same_v<decltype(result),
+                                     Tuple<CopyCounter, int, int, CopyCounter, CopyCounter, CopyCounter, int>>);
+        ASSERT_EQ(c.stats, (CopyStats{0, 1, 3}));
+        ASSERT_EQ(get<6>(result), 5);
+    });
+
+    TesterWithBuilder<1>::test("apply", [](auto &&builder) {
+        auto c1 = make_copy_counter<boq_tuple>();
+        auto c2 = make_copy_counter<std_tuple>();
+
+        auto &&tuple1 = builder.build(boq::Tuple{42, c1, 1.5});
+        auto &&tuple2 = builder.build(std::tuple{42, c2, 1.5});
+
+        auto sum = [](auto i, auto counter, double d) { return i + d + counter.stats.n_copies; };
+        auto v1  = boq::apply(sum, std::forward<decltype(tuple1)>(tuple1));
+        auto v2  = std::apply(sum, std::forward<decltype(tuple2)>(tuple2));
+
+        ASSERT_EQ(v1, v2);
+        ASSERT_EQ(c1, c2);
+    });
+
+    TesterWithBuilder<1>::test("visit_at", [](auto &&builder) {
+        auto &&tup = builder.build(Tuple{42, 2.5, std::string{"abc"}, 'x'});
+
+        auto to_string = []<typename T>(const T &elem) {
+            std::stringstream ss;
+            ss << elem;
+            return ss.str();
+        };
+        ASSERT_EQ(visit_at(std::forward<decltype(tup)>(tup), 0, to_string), "42");
+        ASSERT_EQ(visit_at(std::forward<decltype(tup)>(tup), 1, to_string), "2.5");
+        ASSERT_EQ(visit_at(std::forward<decltype(tup)>(tup), 2, to_string), "abc");
+        ASSERT_EQ(visit_at(std::forward<decltype(tup)>(tup), 3, to_string), "x");
+
+        bool thrown = false;
+        try
+        {
+            visit_at(std::forward<decltype(tup)>(tup), 4, to_string);
+        }
+        catch (const std::out_of_range &)
+        {
+            thrown = true;
+        }
+        ASSERT(thrown);
+    });
+
+    Tester::test("visit_at_modifies_element", []() {
+        Tuple<int, long, short> tup{1, 2L, short{3}};
+        for (size_t i = 0; i < 3; ++i)
+        {
+            visit_at(tup, i, [](auto &elem) { elem *= 10; });
+        }
+        ASSERT_EQ(get<0>(tup), 10);
+        ASSERT_EQ(get<1>(tup), 20L);
+        ASSERT_EQ(get<2>(tup), 30);
+    });
+
+    {
+        // a Tuple of trivial elements is trivial itself, so containers can copy and relocate it with memcpy
+        using trivial_tuple = Tuple<int, double, float>;
+        static_assert(std::is_trivially_copyable_v<trivial_tuple>);
+        static_assert(std::is_trivially_destructible_v<trivial_tuple>);
+        static_assert(std::is_trivially_default_constructible_v<trivial_tuple>);
+        static_assert(std::is_trivially_copy_assignable_v<trivial_tuple>);
+        static_assert(std::is_trivially_move_constructible_v<trivial_tuple>);
+        static_assert(std::is_trivial_v<Tuple<>>);
+        static_assert(std::is_trivially_copyable_v<packed_tuple<char, double, int>>);
+        static_assert(std::is_trivially_copyable_v<Tuple<Tuple<int, char>, float>>);
+
+        static_assert(!std::is_trivially_copyable_v<Tuple<int, std::string>>);
+        static_assert(!std::is_trivially_destructible_v<Tuple<std::string>>);
+        static_assert(!std::is_trivially_default_constructible_v<Tuple<int, std::string>>);
+
+        static_assert(is_trivially_relocatable_v<trivial_tuple>);
+        static_assert(is_trivially_relocatable_v<Tuple<int &, std::unique_ptr<int>, const double &&>>);
+        static_assert(is_trivially_relocatable_v<packed_tuple<std::unique_ptr<int>, char>>);
+        static_assert(!is_trivially_relocatable_v<Tuple<int, std::string>>);
+        static_assert(!is_trivially_relocatable_v<Tuple<CopyCounter>>);
+    }
+
+    Tester::test("piecewise_construct", []() {
+        // can be neither copied nor moved, so it has to be constructed in place
+        struct pinned
+        {
+            pinned(int i_, std::string s_) : i(i_), s(std::move(s_))
+            {
+            }
+            pinned(const pinned &) = delete;
+            pinned(pinned &&)      = delete;
+            int         i;
+            std::string s;
+        };
+
+        auto c = make_copy_counter();
+        c.reset();
+        Tuple<pinned, CopyCounter, CopyCounter, std::string> tup{std::piecewise_construct, forward_as_tuple(3, "abc"),
+                                                                 forward_as_tuple(), forward_as_tuple(c),
+                                                                 forward_as_tuple(size_t{2}, 'x')};
+        ASSERT_EQ(c.reset(), (CopyStats{1, 1, 0}));
+        ASSERT_EQ(get<0>(tup).i, 3);
+        ASSERT_EQ(get<0>(tup).s, "abc");
+        ASSERT_EQ(get<3>(tup), "xx");
+
+        Tuple<> empty{std::piecewise_construct};
+        static_assert(std::is_empty_v<decltype(empty)>);
+    });
+
+    Tester::test("emplace", []() {
+        struct pinned
+        {
+            // elements that can't be moved need a nothrow constructor, a throwing one would leave no element behind
+            explicit pinned(int i_) noexcept : i(i_)
+            {
+            }
+            pinned(const pinned &) = delete;
+            pinned(pinned &&)      = delete;
+            int i;
+        };
+
+        Tuple<pinned, std::string> tup{std::piecewise_construct, forward_as_tuple(1), forward_as_tuple("abc")};
+
+        pinned &p = tup.emplace<0>(42);
+        ASSERT_EQ(&p, &get<0>(tup));
+        ASSERT_EQ(get<0>(tup).i, 42);
+        ASSERT_EQ(tup.emplace<1>(size_t{3}, 'y'), "yyy");
+
+        // the neighbouring elements keep their values
+        struct padded
+        {
+            int  a;
+            char b;
+        };
+        Tuple<padded, char> small{padded{1, 'a'}, 'y'};
+        ASSERT_EQ(small.emplace<0>(padded{2, 'b'}).a, 2);
+        ASSERT_EQ(get<1>(small), 'y');
+
+        // a throwing constructor leaves the element unchanged
+        struct throws_on_negative
+        {
+            explicit throws_on_negative(int i_) : i(i_)
+            {
+                if (i < 0)
+                {
+                    throw std::invalid_argument("negative");
+                }
+            }
+            int i;
+        };
+        Tuple<throws_on_negative, std::string> checked{throws_on_negative{1}, "abc"};
+        bool                                   thrown = false;
+        try
+        {
+            checked.emplace<0>(-1);
+        }
+        catch (const std::invalid_argument &)
+        {
+            thrown = true;
+        }
+        ASSERT_EQ(thrown, true);
+        ASSERT_EQ(get<0>(checked).i, 1);
+        ASSERT_EQ(get<1>(checked), "abc");
+    });
+
+    Tester::test("transform_view", []() {
+        auto c   = make_copy_counter();
+        auto tup = Tuple{42, c, 12U};
+        c.reset();
+
+        int  n_calls = 0;
+        auto view    = make_transform_view(tup, [&]<typename T>(const T &t) {
+            ++n_calls;
+            if constexpr (std::is_integral_v<T>)
+            {
+                return int(t) + 2;
+            }
+            else
+            {
+                return t.stats;
+            }
+        });
+        static_assert(tuple_size_v<decltype(view)> == 3);
+        ASSERT_EQ(n_calls, 0);
+        ASSERT_EQ(get<2>(view), 14);
+        ASSERT_EQ(n_calls, 1);
+
+        get<2>(tup) = 20U;
+        ASSERT_EQ(get<2>(view), 22);
+
+        auto tup2 = materialize(view);
+        static_assert(std::is_same_v<decltype(tup2), Tuple<int, CopyStats, int>>);
+        ASSERT_EQ(get<0>(tup2), 44);
+        ASSERT_EQ(get<2>(tup2), 22);
+        ASSERT_EQ(c.reset(), (CopyStats{0, 0, 0}));
+    });
+
+    Tester::test("filter_view", []() {
+        auto c   = make_copy_counter();
+        auto tup = Tuple{42, 2.3F, c, 3.4, 12U};
+        c.reset();
+
+        auto view = make_filter_view<std::is_integral>(tup);
+        static_assert(tuple_size_v<decltype(view)> == 2);
+        ASSERT_EQ(get<0>(view), 42);
+        ASSERT_EQ(get<1>(view), 12U);
+
+        get<0>(view) = 7;
+        ASSERT_EQ(get<0>(tup), 7);
+
+        auto others = make_filter_view<boq::not_<std::is_integral>::type>(tup);
+        static_assert(tuple_size_v<decltype(others)> == 3);
+        ASSERT_EQ(&get<1>(others), &get<2>(tup));
+        ASSERT_EQ(c.reset(), (CopyStats{0, 0, 0}));
+
+        auto tup2 = materialize(view);
+        static_assert(std::is_same_v<decltype(tup2), Tuple<int, unsigned>>);
+        ASSERT_EQ(get<0>(tup2), 7);
+
+        auto tup3 = materialize(others);
+        static_assert(std::is_same_v<decltype(tup3), Tuple<float, CopyCounter, double>>);
+        ASSERT_EQ(c.reset(), (CopyStats{0, 1, 0}));
+
+        int  i        = 5;
+        auto refs     = Tuple<int &, double, const int &>{i, 1.5, i};
+        auto ref_view = make_filter_view<std::is_reference>(refs);
+        static_assert(std::is_same_v<decltype(materialize(ref_view)), Tuple<int &, const int &>>);
+    });
+
+    Tester::test("view_pipeline", []() {
+        auto c   = make_copy_counter();
+        auto tup = Tuple{1, 2.5, c, std::string{"abc"}, 3U};
+        c.reset();
+
+        // a pipeline over an rvalue tuple owns it: the tuple is moved into the first view and along with each enclosing
+        // view (3 moves), and materialize moves the selected elements out once more
+        auto forward_elem = []<typename T>(T &&t) -> T && { return std::forward<T>(t); };
+        auto result       = materialize(make_filter_view<boq::not_<std::is_integral>::type>(make_transform_view(
+            make_filter_view<boq::not_<std::is_floating_point>::type>(std::move(tup)), forward_elem)));
+        static_assert(std::is_same_v<decltype(result), Tuple<CopyCounter, std::string>>);
+        ASSERT_EQ(get<1>(result), "abc");
+        ASSERT_EQ(c.reset(), (CopyStats{0, 0, 4}));
+    });
+
+    Tester::test("view_over_rvalue_tuple", []() {
+        auto c = make_copy_counter();
+        c.reset();
+
+        // a view over a temporary tuple owns it instead of referring to it, so the view can outlive the full expression
+        auto view = make_transform_view(bits_of_q::make_tuple(std::string(32, 'x'), 2, std::move(c)),
+                                        []<typename T>(const T &t) -> const T & { return t; });
+        static_assert(!std::is_reference_v<decltype(view.base)>);
+        ASSERT_EQ(get<0>(view), std::string(32, 'x'));
+        ASSERT_EQ(get<1>(view), 2);
+        ASSERT_EQ(get<2>(view).reset(), (CopyStats{0, 0, 2}));
+
+        auto filtered = make_filter_view<std::is_integral>(Tuple{1.5, 7, 'a'});
+        static_assert(!std::is_reference_v<decltype(filtered.base)>);
+        ASSERT_EQ(get<0>(filtered), 7);
+        ASSERT_EQ(get<1>(filtered), 'a');
+
+        // lvalue tuples are still referred to, not copied
+        auto tup      = Tuple{1, 2};
+        auto ref_view = make_filter_view<std::is_integral>(tup);
+        static_assert(std::is_reference_v<decltype(ref_view.base)>);
+        ASSERT_EQ(&get<0>(ref_view), &get<0>(tup));
+    });
+
+    Tester::test("comparison", []() {
+        Tuple<int, std::string> a{1, "abc"};
+        Tuple<int, std::string> b{1, "abd"};
+        Tuple<long, std::string> c{1L, "abc"};
+
+        ASSERT(a == a);
+        ASSERT(a != b);
+        ASSERT(a == c);
+        ASSERT(a < b);
+        ASSERT(b > c);
+        ASSERT(a <= c);
+        ASSERT(std::is_eq(a <=> c));
+        static_assert(std::is_same_v<decltype(a <=> b), std::strong_ordering>);
+        static_assert(std::is_same_v<decltype(Tuple{1, 2.0} <=> Tuple{1, 2.0}), std::partial_ordering>);
+
+        static_assert(Tuple{1, 2U} == Tuple{1, 2U});
+        static_assert(Tuple{1, 2U} < Tuple{1, 3U});
+        static_assert(Tuple<>{} == Tuple<>{});
+
+        int  i = 1;
+        int  j = 1;
+        auto r1 = Tuple<int &>{i};
+        auto r2 = Tuple<int &>{j};
+        ASSERT(r1 == r2); // compares the values, not the addresses
+    });
+
+    Tester::test("hash", []() {
+        static_assert(is_bytewise_comparable_v<Tuple<int, unsigned, char *>>);
+        static_assert(is_bytewise_comparable_v<Tuple<uint64_t, Tuple<uint32_t, uint32_t>>>);
+        static_assert(!is_bytewise_comparable_v<Tuple<char, int>>); // padding
+        static_assert(!is_bytewise_comparable_v<Tuple<int, float>>);
+        static_assert(!is_bytewise_comparable_v<Tuple<int &>>);
+        static_assert(!is_bytewise_comparable_v<Tuple<std::string>>);
+
+        std::hash<Tuple<int, int>> hash;
+        ASSERT_EQ(hash(Tuple{1, 2}), hash(Tuple{1, 2}));
+        ASSERT(hash(Tuple{1, 2}) != hash(Tuple{2, 1}));
+        ASSERT(Tuple(1, 2) != Tuple(2, 1));
+
+        std::unordered_map<Tuple<std::string, int>, int> map;
+        map[Tuple<std::string, int>{"a", 1}] = 1;
+        map[Tuple<std::string, int>{"a", 2}] = 2;
+        map[Tuple<std::string, int>{"a", 1}] += 10;
+        ASSERT_EQ(map.size(), 2U);
+        ASSERT_EQ((map[Tuple<std::string, int>{"a", 1}]), 11);
+
+        std::unordered_map<Tuple<uint32_t, uint32_t, uint64_t>, int> map2;
+        for (uint32_t k = 0; k < 100; ++k)
+        {
+            map2[Tuple<uint32_t, uint32_t, uint64_t>{k, k + 1, uint64_t{k} * 3}] = static_cast<int>(k);
+        }
+        ASSERT_EQ(map2.size(), 100U);
+        ASSERT_EQ((map2.at(Tuple<uint32_t, uint32_t, uint64_t>{7U, 8U, uint64_t{21}})), 7);
+    });
+
     static_assert(tuple_size_v<Tuple<int, bool>> == 2);
     static_assert(tuple_size_v<Tuple<int, bool, float, double>> == 4);
 
@@ -150,6 +661,25 @@ main()
         ASSERT_EQ(get<2>(tup2), 3.4);
     });
 
+    Tester::test("allocation_tracker", []() {
+        constexpr size_t size = sizeof(std::array<int, 16>);
+        AllocationTracker::reset();
+
+        auto v = std::make_unique<std::array<int, 16>>();
+        ASSERT_EQ(AllocationTracker::stats(), (AllocStats{1, 0, size, size}));
+        v.reset();
+        ASSERT_EQ(AllocationTracker::stats(), (AllocStats{1, 1, size, size}));
+    });
+
+    TesterWithBuilder<2>::test("tuple_cat_does_not_allocate", [](auto &&builder) {
+        auto &&[tuple1, tuple2] = builder.build(Tuple{42, 1.2}, Tuple{false, 'c'});
+        AllocationTracker::reset();
+
+        auto result = tuple_cat(std::forward<decltype(tuple1)>(tuple1), std::forward<decltype(tuple2)>(tuple2));
+        ASSERT_EQ(get<3>(result), 'c');
+        ASSERT_ALLOCS_LE(0);
+    });
+
     /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     //                                                                                                                 //
     //  Homework exercise: Update filter to make it work correctly with references! (solution available on github). //
@@ -1,40 +1,177 @@
 #!/usr/bin/perl
 
+# Measures the compile time of main_slow.cpp and main_fast.cpp relative to main.cpp (the baseline).
+#
+# usage: ./time_builds.pl <n_compilations> [n_warmups] [sequential]
+#
+# Every compilation is timed separately (user + system CPU time of the compiler, like /usr/bin/time %U + %S), after
+# n_warmups (default 2) untimed compilations of each file. The three files are compiled round-robin, so drift in
+# machine load affects all of them alike. For every file the median, the median absolute deviation (MAD) and a 95%
+# confidence interval of the median are reported; the speedup is reported with a bootstrapped 95% confidence interval.
+#
+# Each compiler is pinned to its own CPU core (using taskset, if available, and only to the cores this process may run
+# on) and, when there are enough cores, the compilers are benchmarked in parallel to keep the total wall time down. As
+# CPU time rather than wall clock time is measured, waiting for the other compiler doesn't count, although sharing the
+# memory bandwidth and the last level cache still does: pass 1 for sequential to benchmark them one after the other.
+
 use strict;
 use warnings;
+use POSIX qw(floor ceil);
 
 if($#ARGV < 0){
-	print STDERR "please specify the number of compilations";
-	print STDERR "#ARGV:".$#ARGV;
+	print STDERR "please specify the number of compilations\n";
 	exit 1;
 }
 
 my $n_compilations = $ARGV[0];
+my $n_warmups = $#ARGV >= 1 ? $ARGV[1] : 2;
+my $sequential = $#ARGV >= 2 ? $ARGV[2] : 0;
+my @compilers = ("gcc", "clang");
+my %compile_commands = (
+	gcc => "g++ -O2 -std=c++20",
+	clang => "clang++ -O2 -std=c++20",
+);
+my @files = ("main.cpp", "main_slow.cpp", "main_fast.cpp");
 
-sub trim{
-	my $str = shift;
-	$str =~ s/^\s+|\s+$//;
-	return $str;
+# the ids of the cores this process may run on, which are not necessarily 0 .. nproc - 1 (e.g. in a cpuset)
+sub allowed_cores{
+	my $list;
+	if(open(my $status, "<", "/proc/self/status")){
+		while(<$status>){
+			$list = $1 if /^Cpus_allowed_list:\s*(\S+)/;
+		}
+		close($status);
+	}
+	if(!defined($list) && `taskset -pc $$ 2>/dev/null` =~ /:\s*(\S+)\s*$/){
+		$list = $1;
+	}
+	return () if !defined($list);
+	return map { /^(\d+)-(\d+)$/ ? ($1 .. $2) : ($_) } split(/,/, $list);
 }
 
+my $have_taskset = system("which taskset >/dev/null 2>&1") == 0;
+my @cores = $have_taskset ? allowed_cores() : ();
+my $parallel = !$sequential && @cores >= @compilers;
 
-sub benchmark{
-	my $compiler = shift;
-	my ($baseline, $slow, $fast);
+# differences below this (in seconds) are considered noise
+my $epsilon = 0.0005;
+
+sub median{
+	my @sorted = sort { $a <=> $b } @_;
+	my $n = @sorted;
+	return $n % 2 ? $sorted[$n / 2] : ($sorted[$n / 2 - 1] + $sorted[$n / 2]) / 2;
+}
+
+sub mad{
+	my $median = median(@_);
+	return median(map { abs($_ - $median) } @_);
+}
+
+# distribution free confidence interval of the median, based on the order statistics (normal approximation of the
+# binomial distribution)
+sub median_ci{
+	my @sorted = sort { $a <=> $b } @_;
+	my $n = @sorted;
+	my $lower = floor($n / 2 - 1.96 * sqrt($n) / 2);
+	my $upper = ceil($n / 2 + 1.96 * sqrt($n) / 2) - 1;
+	$lower = 0 if $lower < 0;
+	$upper = $n - 1 if $upper > $n - 1;
+	return ($sorted[$lower], $sorted[$upper]);
+}
 
-	print("========= $compiler x $n_compilations ==========\n");
-	eval "\$baseline = ".trim(`/usr/bin/time --format "%U + %S" ./build_$compiler.sh main.cpp $n_compilations 2>&1`);
-	printf("baseline: %.3fs\n", $baseline);
+sub resample{
+	return map { $_[int(rand(@_))] } @_;
+}
+
+my $n_resamples = 1000;
+
+# 95% confidence interval of (median(slow) - median(base)) / (median(fast) - median(base)), followed by the number of
+# resamples in which fast wasn't measurably slower than the baseline. These have no finite speedup, so the interval is
+# only returned (otherwise undef) if at most 2% of the resamples had to be dropped.
+sub speedup_ci{
+	my ($base, $slow, $fast) = @_;
+	my @speedups;
+	my $n_dropped = 0;
+	foreach (1 .. $n_resamples){
+		my $base_median = median(resample(@$base));
+		my $denominator = median(resample(@$fast)) - $base_median;
+		if($denominator < $epsilon){
+			$n_dropped++;
+			next;
+		}
+		push(@speedups, (median(resample(@$slow)) - $base_median) / $denominator);
+	}
+	return (undef, undef, $n_dropped) if $n_dropped > 0.02 * $n_resamples;
+	@speedups = sort { $a <=> $b } @speedups;
+	return ($speedups[int(0.025 * @speedups)], $speedups[int(0.975 * @speedups) - 1], $n_dropped);
+}
 
-	eval "\$slow = ".trim(`/usr/bin/time --format "%U + %S" ./build_$compiler.sh main_slow.cpp $n_compilations 2>&1`);
-	printf("slow - baseline: %.3fs\n",$slow-$baseline);
-	eval "\$fast = ".trim(`/usr/bin/time --format "%U + %S" ./build_$compiler.sh main_fast.cpp $n_compilations 2>&1`);
-	printf("fast - baseline: %.3fs    (%.2f x faster)\n",$fast-$baseline,(($slow-$baseline) / ($fast-$baseline)));
+# user + system CPU time of the command
+sub time_of{
+	my $command = shift;
+	my @start = times();
+	system($command);
+	die "'$command' failed\n" if $? != 0;
+	my @end = times();
+	return ($end[2] + $end[3]) - ($start[2] + $start[3]);
 }
 
-benchmark("gcc");
-benchmark("clang");
+sub benchmark{
+	my ($compiler, $core) = @_;
+	my $output = "a_$compiler.out";
+	my $pin = defined($core) ? "taskset -c $core " : "";
+	my %samples = map { $_ => [] } @files;
 
-`rm a.out`
+	foreach my $i (1 .. $n_warmups + $n_compilations){
+		foreach my $file (@files){
+			my $t = time_of("$pin$compile_commands{$compiler} $file -o $output");
+			push(@{$samples{$file}}, $t) if $i > $n_warmups;
+		}
+	}
+	unlink($output);
 
+	srand(42);
+	my %median = map { $_ => median(@{$samples{$_}}) } @files;
+	my $pinned = defined($core) ? ", core $core" : "";
+	my $report = "========= $compiler x $n_compilations (+ $n_warmups warmups$pinned) ==========\n";
+	$report .= sprintf("%-14s %9s %9s %21s\n", "file", "median", "MAD", "95% CI of median");
+	foreach my $file (@files){
+		my ($lower, $upper) = median_ci(@{$samples{$file}});
+		$report .= sprintf("%-14s %8.3fs %8.3fs     [%.3fs, %.3fs]\n", $file, $median{$file}, mad(@{$samples{$file}}),
+			$lower, $upper);
+	}
+	my $slow = $median{"main_slow.cpp"} - $median{"main.cpp"};
+	my $fast = $median{"main_fast.cpp"} - $median{"main.cpp"};
+	$report .= sprintf("slow - baseline: %.3fs\n", $slow);
+	if($fast >= $epsilon){
+		my ($lower, $upper, $n_dropped) = speedup_ci(@samples{@files});
+		my $ci = defined($lower) ? sprintf("[%.2f, %.2f]", $lower, $upper) : "n/a";
+		$report .= sprintf("fast - baseline: %.3fs    (%.2f x faster, 95%% CI %s, %d of %d resamples dropped)\n", $fast,
+			$slow / $fast, $ci, $n_dropped, $n_resamples);
+	}
+	else{
+		$report .= sprintf("fast - baseline: %.3fs    (not measurably slower than the baseline)\n", $fast);
+	}
+	return $report;
+}
 
+if($parallel){
+	# one child process per compiler, each pinned to its own core, counting down from the last allowed core
+	my @pipes;
+	foreach my $i (0 .. $#compilers){
+		my $pid = open(my $pipe, "-|");
+		die "fork failed: $!\n" if !defined($pid);
+		if($pid == 0){
+			print(benchmark($compilers[$i], $cores[-1 - $i]));
+			exit 0;
+		}
+		push(@pipes, $pipe);
+	}
+	foreach my $pipe (@pipes){
+		print(<$pipe>);
+		close($pipe);
+	}
+}
+else{
+	print(benchmark($_, $cores[0])) foreach @compilers;
+}
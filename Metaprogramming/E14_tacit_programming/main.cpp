@@ -38,6 +38,23 @@ struct same_as_pred
 #ifndef INPUT
 #define INPUT input1024_same4
 #endif
+
+// When EMIT_SYMBOLS is defined, the resulting type of each algorithm is passed to a non-inlined function template, so
+// that a symbol containing the (mangled) result type ends up in the object file. Used by measure_symbols.pl.
+// All remove_if variants have the same result type (and so do all join variants), so this only makes sure the
+// computation isn't discarded. The intermediate instantiations, which is where the variants differ, are counted by
+// measure_symbols.pl in the debug info (compiled with -fno-eliminate-unused-debug-types).
+#ifdef EMIT_SYMBOLS
+template <typename T>
+[[gnu::noinline]] void
+emit_symbol(const T &)
+{
+    asm volatile("");
+}
+#define EMIT_SYMBOL(t) emit_symbol(t)
+#else
+#define EMIT_SYMBOL(t)
+#endif
 //*
 // using input10240_same4 =
 //    composed_selection1024::join_t<input2048_same4, input2048_same4, input2048_same4, input2048_same4,
@@ -54,6 +71,22 @@ struct same_as_pred
 // #define INPUT input10240_same4
 // #define INPUT input51200_same4
 
+// Joins the elements of LIST as single element lists, like remove_if does for the elements that are kept.
+// The unused parameter T makes the type dependent, so that only the selected ALGO is instantiated.
+template <template <typename...> class JOIN, typename LIST, typename T>
+struct join_singletons;
+
+template <template <typename...> class JOIN, typename... Ts, typename T>
+struct join_singletons<JOIN, type_list<Ts...>, T>
+{
+    using type = JOIN<type_list<Ts>...>;
+};
+
+template <template <typename...> class JOIN, typename T>
+using join_singletons_t = typename join_singletons<JOIN, INPUT, T>::type;
+
+// ALGO 0 runs no algorithm at all and is the baseline the other numbers are compared against, ALGO 1-9 are the
+// remove_if variants and ALGO 10-17 the join variants they are composed of.
 template <typename T>
 void
 run_test()
@@ -62,40 +95,89 @@ run_test()
     if constexpr (i == 1)
     {
         [[maybe_unused]] naive::remove_if<same_as_pred<T>::template predicate, INPUT> t{};
+        EMIT_SYMBOL(t);
     }
     if constexpr (i == 2)
     {
         [[maybe_unused]] naive_lazy::remove_if<same_as_pred<T>::template predicate, INPUT> t{};
+        EMIT_SYMBOL(t);
     }
     if constexpr (i == 3)
     {
         [[maybe_unused]] composed::remove_if<same_as_pred<T>::template predicate, INPUT> t{};
+        EMIT_SYMBOL(t);
     }
     if constexpr (i == 4)
     {
         [[maybe_unused]] composed_fast_track::remove_if<same_as_pred<T>::template predicate, INPUT> t{};
+        EMIT_SYMBOL(t);
     }
     if constexpr (i == 5)
     {
         [[maybe_unused]] composed_fast_track64::remove_if<same_as_pred<T>::template predicate, INPUT> t{};
+        EMIT_SYMBOL(t);
     }
     if constexpr (i == 6)
     {
         [[maybe_unused]] composed_defaults::remove_if<same_as_pred<T>::template predicate, INPUT> t{};
+        EMIT_SYMBOL(t);
     }
     if constexpr (i == 7)
     {
         [[maybe_unused]] composed_defaults64::remove_if<same_as_pred<T>::template predicate, INPUT> t{};
+        EMIT_SYMBOL(t);
     }
     if constexpr (i == 8)
     {
         //[[maybe_unused]] composed_selection64::remove_if<same_as_pred<T>::template predicate, INPUT> t{};
         [[maybe_unused]] composed_selection1024::remove_if<same_as_pred<T>::template predicate, INPUT> t{};
+        EMIT_SYMBOL(t);
     }
     if constexpr (i == 9)
     {
         namespace hp = high_performance;
         [[maybe_unused]] hp::unpack<hp::remove_if<hp::to_lazy_predicate<std::is_void>>>::template f<INPUT> t{};
+        EMIT_SYMBOL(t);
+    }
+    if constexpr (i == 10)
+    {
+        [[maybe_unused]] join_singletons_t<composed::join_t, T> t{};
+        EMIT_SYMBOL(t);
+    }
+    if constexpr (i == 11)
+    {
+        [[maybe_unused]] join_singletons_t<composed_fast_track::join_t, T> t{};
+        EMIT_SYMBOL(t);
+    }
+    if constexpr (i == 12)
+    {
+        [[maybe_unused]] join_singletons_t<composed_fast_track64::join_t, T> t{};
+        EMIT_SYMBOL(t);
+    }
+    if constexpr (i == 13)
+    {
+        [[maybe_unused]] join_singletons_t<composed_defaults::join_t, T> t{};
+        EMIT_SYMBOL(t);
+    }
+    if constexpr (i == 14)
+    {
+        [[maybe_unused]] join_singletons_t<composed_defaults64::join_t, T> t{};
+        EMIT_SYMBOL(t);
+    }
+    if constexpr (i == 15)
+    {
+        [[maybe_unused]] join_singletons_t<composed_selection64::join_t, T> t{};
+        EMIT_SYMBOL(t);
+    }
+    if constexpr (i == 16)
+    {
+        [[maybe_unused]] join_singletons_t<composed_selection1024::join_t, T> t{};
+        EMIT_SYMBOL(t);
+    }
+    if constexpr (i == 17)
+    {
+        [[maybe_unused]] join_singletons_t<join<>::template f, T> t{};
+        EMIT_SYMBOL(t);
     }
 }
 int
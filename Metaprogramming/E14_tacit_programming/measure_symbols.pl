@@ -0,0 +1,113 @@
+#!/usr/bin/perl
+
+# Reports the "binary footprint" of the different remove_if implementations (and the join implementations they are
+# composed of): mangled symbol length, number of instantiated types, object file size, debug info size and link time.
+#
+# usage: ./measure_symbols.pl [input] [compiler...]
+#   input:    one of the type lists from BenchmarkInputs.h (default: input1024_same4)
+#   compiler: g++ and/or clang++ (default: every one of them that is installed)
+#
+# The continuation-style implementation (ALGO 9, see HighPerformance.h) is measured next to the ::type based ones
+# (ALGO 1-8), so the numbers show whether avoiding the intermediate structs actually reduces what ends up in the object
+# file.
+#
+# All remove_if variants end up with the same result type, so the mangled symbols mostly show the cost of the
+# continuation style. Where the variants really differ is in the intermediate class template instantiations; these are
+# counted as the structure/class types in the debug info (compiled with -fno-eliminate-unused-debug-types). ALGO 0
+# runs no algorithm at all and is the baseline to subtract.
+#
+# Note: the naive implementation (ALGO 1) takes a very long time for anything but the smallest inputs.
+
+use strict;
+use warnings;
+use Time::HiRes qw(time);
+
+my $input = $#ARGV >= 0 ? shift @ARGV : "input1024_same4";
+my @compilers = @ARGV ? @ARGV : grep { `which $_ 2>/dev/null` } ("g++", "clang++");
+
+my %algo_names = (
+	0 => "baseline (no algorithm)",
+	1 => "naive",
+	2 => "naive_lazy",
+	3 => "composed",
+	4 => "composed_fast_track",
+	5 => "composed_fast_track64",
+	6 => "composed_defaults",
+	7 => "composed_defaults64",
+	8 => "composed_selection1024",
+	9 => "high_performance (continuations)",
+	10 => "join: composed",
+	11 => "join: composed_fast_track",
+	12 => "join: composed_fast_track64",
+	13 => "join: composed_defaults",
+	14 => "join: composed_defaults64",
+	15 => "join: composed_selection64",
+	16 => "join: composed_selection1024",
+	17 => "join: high_performance",
+);
+
+sub section_size{
+	my ($object, $section) = @_;
+	foreach my $line (`objdump -h $object`){
+		# Idx Name Size VMA LMA File-off Algn
+		if($line =~ /^\s*\d+\s+\Q$section\E\s+([0-9a-fA-F]+)/){
+			return hex($1);
+		}
+	}
+	return 0;
+}
+
+sub debug_types{
+	my $object = shift;
+	my $count = 0;
+	foreach my $line (`objdump --dwarf=info $object`){
+		$count++ if $line =~ /DW_TAG_(structure|class)_type/;
+	}
+	return $count;
+}
+
+sub symbol_stats{
+	my $object = shift;
+	my ($count, $total, $max) = (0, 0, 0);
+	foreach my $line (`nm $object`){
+		chomp $line;
+		my @fields = split(/\s+/, $line);
+		my $symbol = $fields[-1];
+		$count++;
+		$total += length($symbol);
+		$max = length($symbol) if length($symbol) > $max;
+	}
+	return ($count, $total, $max);
+}
+
+sub measure{
+	my ($compiler, $algo) = @_;
+	my $object = "measure_symbols_$algo.o";
+	my $binary = "measure_symbols_$algo.out";
+
+	my $start = time();
+	system("$compiler -O2 -g -fno-eliminate-unused-debug-types -std=c++20 -DBENCHMARK -DEMIT_SYMBOLS -DALGO=$algo -DINPUT=$input -c main.cpp -o $object 2>/dev/null");
+	my $compile_time = time() - $start;
+	if($? != 0){
+		printf("%-34s  failed to compile\n", $algo_names{$algo});
+		return;
+	}
+
+	$start = time();
+	system("$compiler $object -o $binary");
+	my $link_time = time() - $start;
+
+	my ($n_symbols, $total_length, $max_length) = symbol_stats($object);
+	printf("%-34s %8d %10d %9d %7d %10d %12d %11d %9.3f %9.3f\n",
+		$algo_names{$algo}, $n_symbols, $total_length, $max_length, debug_types($object), -s $object,
+		section_size($object, ".debug_info"), section_size($object, ".debug_str"), $compile_time, $link_time);
+
+	unlink($object, $binary);
+}
+
+foreach my $compiler (@compilers){
+	print("========= $compiler / $input ==========\n");
+	printf("%-34s %8s %10s %9s %7s %10s %12s %11s %9s %9s\n",
+		"algorithm", "symbols", "sym bytes", "max sym", "types", ".o bytes", ".debug_info", ".debug_str", "compile", "link");
+	measure($compiler, $_) foreach sort { $a <=> $b } keys %algo_names;
+}